@@ -0,0 +1,226 @@
+#include "exchange.hpp"
+#include "order_book.hpp"
+#include "order.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+using namespace trading;
+using BenchClock = std::chrono::steady_clock;
+
+// Resting orders placed before the Exchange scenario starts
+constexpr int INITIAL_RESTING = 10000;
+
+// Stream buffer that discards everything (silences exchange logging while timing)
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override {
+        return c;
+    }
+};
+
+// Latency samples for one operation type
+struct OpStats {
+    std::string name;
+    std::vector<std::uint64_t> samples;  // Nanoseconds per sample
+    std::size_t opsPerSample = 1;        // Operations covered by one sample (batch size)
+};
+
+// Time a single operation in nanoseconds
+template <typename Fn>
+void timeOp(OpStats& stats, Fn&& fn) {
+    auto start = BenchClock::now();
+    fn();
+    auto end = BenchClock::now();
+    stats.samples.push_back(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+}
+
+// Percentile of sorted samples
+std::uint64_t percentile(const std::vector<std::uint64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    std::size_t index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1));
+    return sorted[index];
+}
+
+// Print throughput and latency percentiles for each operation type
+void report(const std::string& scenario, std::vector<OpStats> allStats) {
+    std::cout << "\n" << scenario << "\n";
+    std::cout << std::left << std::setw(22) << "operation"
+              << std::right << std::setw(10) << "count"
+              << std::setw(14) << "ops/sec"
+              << std::setw(10) << "p50 ns"
+              << std::setw(10) << "p99 ns"
+              << std::setw(12) << "p99.9 ns" << "\n";
+    for (auto& stats : allStats) {
+        if (stats.samples.empty()) {
+            continue;
+        }
+        std::uint64_t total = 0;
+        for (std::uint64_t sample : stats.samples) {
+            total += sample;
+        }
+        std::sort(stats.samples.begin(), stats.samples.end());
+        // Throughput counts individual operations; percentiles stay per sample
+        double ops = static_cast<double>(stats.samples.size() * stats.opsPerSample);
+        double opsPerSec = total > 0 ? 1e9 * ops / static_cast<double>(total) : 0.0;
+        std::cout << std::left << std::setw(22) << stats.name
+                  << std::right << std::setw(10) << stats.samples.size()
+                  << std::setw(14) << std::fixed << std::setprecision(0) << opsPerSec
+                  << std::setw(10) << percentile(stats.samples, 0.50)
+                  << std::setw(10) << percentile(stats.samples, 0.99)
+                  << std::setw(12) << percentile(stats.samples, 0.999) << "\n";
+    }
+}
+
+// Raw OrderBook: deep book build-up, cancels and quote sampling
+std::vector<OpStats> benchOrderBook(std::size_t numOps, std::mt19937_64& rng) {
+    const TraderId trader = 1;
+    const Price mid(100.0);
+    std::uniform_int_distribution<int> tickDist(1, 200);
+    std::uniform_real_distribution<double> qtyDist(1.0, 50.0);
+    std::uniform_real_distribution<double> uniDist(0.0, 1.0);
+
+    std::vector<OpStats> stats = {{"add", {}}, {"cancel", {}}, {"top of book", {}}, {"depth snapshot", {}}};
+    OrderBook book;
+    std::vector<OrderId> resting;
+    resting.reserve(numOps);
+    std::array<LevelView, 10> depth{};
+
+    for (std::size_t i = 0; i < numOps; ++i) {
+        double action = uniDist(rng);
+        if (action < 0.55 || resting.empty()) {
+            bool isBuy = uniDist(rng) < 0.5;
+            Price offset = Price::fromRaw(tickDist(rng));
+            Price price = isBuy ? mid - offset : mid + offset;
+            auto order = std::make_shared<LimitOrder>(trader, price, qtyDist(rng), isBuy);
+            resting.push_back(order->getId());
+            timeOp(stats[0], [&] { book.addOrder(std::move(order)); });
+        } else if (action < 0.85) {
+            std::uniform_int_distribution<std::size_t> pick(0, resting.size() - 1);
+            std::size_t index = pick(rng);
+            OrderId id = resting[index];
+            resting[index] = resting.back();
+            resting.pop_back();
+            timeOp(stats[1], [&] { book.removeOrder(id); });
+        } else if (action < 0.95) {
+            volatile std::int64_t sink = 0;
+            timeOp(stats[2], [&] { sink = book.getTopOfBook().bid.price.raw(); });
+        } else {
+            timeOp(stats[3], [&] { book.snapshotDepth(true, depth.size(), depth); });
+        }
+    }
+    return stats;
+}
+
+// Exchange::submitOrder with passive, cancel and marketable flow
+std::vector<OpStats> benchExchange(std::size_t numOps, std::mt19937_64& rng) {
+    const Price mid(100.0);
+    std::uniform_int_distribution<int> tickDist(1, 100);
+    std::uniform_real_distribution<double> qtyDist(1.0, 20.0);
+    std::uniform_real_distribution<double> uniDist(0.0, 1.0);
+
+    std::vector<OpStats> stats = {{"submit passive", {}}, {"cancel", {}},
+                                  {"submit marketable", {}}, {"submit market", {}},
+                                  {"submit batch x64", {}}};
+    Exchange exchange;
+    auto maker = exchange.registerTrader();
+    auto taker = exchange.registerTrader();
+    std::vector<OrderId> resting;
+    resting.reserve(numOps);
+    std::vector<Trade> fills;
+    VectorTradeSink sink(fills);
+
+    // Deep initial book
+    for (int i = 0; i < INITIAL_RESTING; ++i) {
+        bool isBuy = (i % 2) == 0;
+        Price offset = Price::fromRaw(tickDist(rng));
+        auto order = maker->createLimitOrder(isBuy ? mid - offset : mid + offset, qtyDist(rng), isBuy);
+        resting.push_back(order->getId());
+        exchange.submitOrder(order);
+    }
+
+    for (std::size_t i = 0; i < numOps; ++i) {
+        double action = uniDist(rng);
+        bool isBuy = uniDist(rng) < 0.5;
+        fills.clear();
+        if (action < 0.5 || resting.empty()) {
+            Price offset = Price::fromRaw(tickDist(rng));
+            auto order = maker->createLimitOrder(isBuy ? mid - offset : mid + offset, qtyDist(rng), isBuy);
+            resting.push_back(order->getId());
+            timeOp(stats[0], [&] { exchange.submitOrder(order, sink); });
+        } else if (action < 0.8) {
+            std::uniform_int_distribution<std::size_t> pick(0, resting.size() - 1);
+            std::size_t index = pick(rng);
+            OrderId id = resting[index];
+            resting[index] = resting.back();
+            resting.pop_back();
+            timeOp(stats[1], [&] { exchange.cancelOrder(id); });
+        } else if (action < 0.95) {
+            Price offset = Price::fromRaw(tickDist(rng) / 10);
+            auto order = taker->createLimitOrder(isBuy ? mid + offset : mid - offset, qtyDist(rng), isBuy);
+            timeOp(stats[2], [&] { exchange.submitOrder(order, sink); });
+        } else {
+            auto order = taker->createMarketOrder(qtyDist(rng), isBuy);
+            timeOp(stats[3], [&] { exchange.submitOrder(order, sink); });
+        }
+    }
+
+    // Mixed passive and marketable flow submitted in batches
+    const std::size_t batchSize = 64;
+    stats[4].opsPerSample = batchSize;
+    std::vector<std::shared_ptr<Order>> batch;
+    batch.reserve(batchSize);
+    for (std::size_t i = 0; i + batchSize <= numOps / 4; i += batchSize) {
+        batch.clear();
+        for (std::size_t j = 0; j < batchSize; ++j) {
+            bool isBuy = uniDist(rng) < 0.5;
+            bool marketable = uniDist(rng) < 0.2;
+            Price offset = Price::fromRaw(marketable ? tickDist(rng) / 10 : tickDist(rng));
+            Price price = (isBuy != marketable) ? mid - offset : mid + offset;
+            batch.push_back((marketable ? taker : maker)->createLimitOrder(price, qtyDist(rng), isBuy));
+        }
+        fills.clear();
+        timeOp(stats[4], [&] { exchange.submitOrders(batch, sink); });
+    }
+    return stats;
+}
+
+int main(int argc, char** argv) {
+    std::size_t numOps = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    std::uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 42;
+    std::mt19937_64 rng(seed);
+
+#ifdef TRADING_FLAT_LADDER
+    std::cout << "Book sides: flat tick ladder\n";
+#else
+    std::cout << "Book sides: std::map\n";
+#endif
+#ifdef TRADING_SILENT
+    std::cout << "Event reporting: compiled out\n";
+#endif
+    std::cout << "Operations per scenario: " << numOps << ", seed: " << seed << "\n";
+
+    // Exchange logging goes to std::cout, so discard it while timing
+    NullBuffer nullBuffer;
+    std::streambuf* original = std::cout.rdbuf();
+    std::cout.rdbuf(&nullBuffer);
+    std::vector<OpStats> bookStats = benchOrderBook(numOps, rng);
+    std::vector<OpStats> exchangeStats = benchExchange(numOps, rng);
+    std::cout.rdbuf(original);
+
+    report("OrderBook (up to 200 levels per side)", std::move(bookStats));
+    report("Exchange::submitOrder (" + std::to_string(INITIAL_RESTING) + " resting orders at start)",
+           std::move(exchangeStats));
+    return 0;
+}
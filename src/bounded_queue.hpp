@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace trading {
+
+// Lock-free bounded multi-producer/multi-consumer ring buffer.
+// Each cell carries a sequence number that tells producers and consumers whose
+// turn it is, so a push or pop is one CAS on the position plus one store.
+// Capacity is rounded up to a power of two; T must be default-constructible.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity);
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Push a copy of value (false if the queue is full)
+    bool tryPush(const T& value);
+
+    // Pop the oldest value into out (false if the queue is empty)
+    bool tryPop(T& out);
+
+    // Number of cells
+    std::size_t capacity() const {
+        return mask + 1;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask;
+    alignas(CACHE_LINE) std::atomic<std::size_t> enqueuePos{0};
+    alignas(CACHE_LINE) std::atomic<std::size_t> dequeuePos{0};
+};
+
+// BoundedQueue implementation
+
+template <typename T>
+BoundedQueue<T>::BoundedQueue(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    cells = std::make_unique<Cell[]>(size);
+    mask = size - 1;
+    for (std::size_t i = 0; i < size; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool BoundedQueue<T>::tryPush(const T& value) {
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[pos & mask];
+        std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            // Cell is free for this position; claim it
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.value = value;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // Still holds a value from the previous lap
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+bool BoundedQueue<T>::tryPop(T& out) {
+    std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[pos & mask];
+        std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+        if (diff == 0) {
+            // Cell holds the value for this position; claim it
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                out = std::move(cell.value);
+                cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // Not yet written
+        } else {
+            pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+}
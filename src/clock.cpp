@@ -0,0 +1,37 @@
+#include "clock.hpp"
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace trading {
+
+// Convert a monotonic timestamp to nanoseconds since the Unix epoch
+std::int64_t toWallClockNanos(Timestamp timestamp) {
+    static const std::int64_t offset =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count() - monotonicNanos();
+    return timestamp + offset;
+}
+
+// Format nanoseconds since the epoch as local time with millisecond detail
+std::string formatWallClock(std::int64_t nanosSinceEpoch) {
+    std::time_t seconds = static_cast<std::time_t>(nanosSinceEpoch / 1000000000);
+    std::int64_t ms = (nanosSinceEpoch / 1000000) % 1000;
+    std::tm local{};
+#if defined(_WIN32)
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+    std::stringstream ss;
+    ss << std::put_time(&local, "%Y-%m-%d %H:%M:%S")
+       << '.' << std::setfill('0') << std::setw(3) << ms;
+    return ss.str();
+}
+
+// Format a monotonic timestamp as local time with millisecond detail
+std::string formatTimestamp(Timestamp timestamp) {
+    return formatWallClock(toWallClockNanos(timestamp));
+}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace trading {
+
+// Monotonic nanoseconds from an arbitrary origin (std::chrono::steady_clock)
+using Timestamp = std::int64_t;
+
+// Read the monotonic clock (vDSO clock_gettime on Linux; no syscall or locale work)
+inline Timestamp monotonicNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Convert a monotonic timestamp to nanoseconds since the Unix epoch.
+// The offset between the two clocks is captured once, on first use.
+std::int64_t toWallClockNanos(Timestamp timestamp);
+
+// Format nanoseconds since the epoch as local time with millisecond detail
+std::string formatWallClock(std::int64_t nanosSinceEpoch);
+
+// Format a monotonic timestamp as local time with millisecond detail
+std::string formatTimestamp(Timestamp timestamp);
+
+}
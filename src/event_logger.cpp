@@ -0,0 +1,110 @@
+#include "event_logger.hpp"
+#include <iomanip>
+#include <string_view>
+
+namespace trading {
+
+// Constructor: start the writer thread
+EventLogger::EventLogger(std::ostream& out, std::size_t capacity): out(out), queue(capacity) {
+    worker = std::thread(&EventLogger::run, this);
+}
+
+// Destructor: write whatever is still queued, then stop the writer
+EventLogger::~EventLogger() {
+    stopping.store(true, std::memory_order_release);
+    worker.join();
+}
+
+// Block until every event queued so far has been written and flushed
+void EventLogger::flush() const {
+    std::uint64_t target = logged.load(std::memory_order_acquire);
+    while (written.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+
+// Number of times log() found the ring full
+std::uint64_t EventLogger::getStalls() const {
+    return stalls.load(std::memory_order_relaxed);
+}
+
+// Background loop: drain, write, flush, sleep
+void EventLogger::run() {
+    LogEvent event;
+    std::uint64_t count = 0;
+    for (;;) {
+        bool stop = stopping.load(std::memory_order_acquire);
+        bool wroteAny = false;
+        while (queue.tryPop(event)) {
+            write(event);
+            ++count;
+            wroteAny = true;
+        }
+        if (wroteAny) {
+            out.flush();
+            written.store(count, std::memory_order_release);
+        }
+        if (stop) {
+            return;
+        }
+        if (!wroteAny) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+}
+
+// Format one event as a log line and write it out
+void EventLogger::write(const LogEvent& event) {
+    const char* side = event.isBuy ? "Buy" : "Sell";
+    line.str({});
+    line << std::defaultfloat << std::setprecision(6) << "[" << formatTimestamp(event.timestamp) << "] ";
+    switch (event.type) {
+        case EventType::TRADE:
+            line << std::fixed << std::setprecision(2)
+                 << "TRADE EXECUTED: " << event.quantity << " units at $" << event.price
+                 << " | Buyer: " << formatTraderId(event.traderId)
+                 << " (Order " << formatOrderId(event.orderId) << ")"
+                 << " | Seller: " << formatTraderId(event.otherTraderId)
+                 << " (Order " << formatOrderId(event.otherOrderId) << ")";
+            break;
+        case EventType::NO_MATCH:
+            line << "ORDER STATUS: " << side << " order " << formatOrderId(event.orderId)
+                 << " (Trader " << formatTraderId(event.traderId) << ") - No matching "
+                 << (event.isBuy ? "sell" : "buy") << " orders available";
+            break;
+        case EventType::RESTED:
+            line << "ORDER STATUS: " << side << " limit order " << formatOrderId(event.orderId)
+                 << " (Trader " << formatTraderId(event.traderId) << ") - Price $" << event.price
+                 << (event.isBuy ? " below best ask $" : " above best bid $") << event.bestPrice
+                 << " - Order added to book";
+            break;
+        case EventType::COMPLETE:
+            line << "ORDER COMPLETE: " << side << " order " << formatOrderId(event.orderId)
+                 << " (Trader " << formatTraderId(event.traderId) << ") fully executed for "
+                 << event.quantity << " units";
+            break;
+        case EventType::PARTIAL:
+            line << "ORDER PARTIAL: " << side << " order " << formatOrderId(event.orderId)
+                 << " (Trader " << formatTraderId(event.traderId) << ") " << event.quantity
+                 << " filled, " << event.remaining << " remaining";
+            break;
+        case EventType::TRADER_REGISTERED:
+            line << "TRADER REGISTERED: " << formatTraderId(event.traderId);
+            break;
+        case EventType::CANCELLED:
+            line << "ORDER CANCELLED: " << side << " order " << formatOrderId(event.orderId)
+                 << " (Trader " << formatTraderId(event.traderId) << ") - " << event.remaining
+                 << " unfilled units cancelled";
+            break;
+        case EventType::SELF_TRADE_PREVENTED:
+            line << "SELF-TRADE PREVENTED: " << side << " order " << formatOrderId(event.orderId)
+                 << " (Trader " << formatTraderId(event.traderId) << ") - " << event.quantity
+                 << " units cancelled against the trader's own order";
+            break;
+    }
+    line << '\n';
+    std::string_view text = line.view();
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "bounded_queue.hpp"
+#include "clock.hpp"
+#include "order.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace trading {
+
+// Kind of event recorded by the exchange
+enum class EventType : std::uint8_t {
+    TRADE,              // orderId buys from otherOrderId
+    NO_MATCH,           // Opposite side empty
+    RESTED,             // Limit price does not cross bestPrice
+    COMPLETE,           // Incoming order fully executed for quantity
+    PARTIAL,            // quantity filled, remaining left over
+    TRADER_REGISTERED,  // traderId joined
+    CANCELLED,          // IOC/FOK order's remaining quantity cancelled unfilled
+    SELF_TRADE_PREVENTED  // quantity taken off an order that met its own trader's order
+};
+
+// Fixed-size binary log record; formatted to text off the matching path
+struct LogEvent {
+    Timestamp timestamp = 0;     // When the event happened (converted to wall clock on output)
+    EventType type = EventType::TRADE;
+    bool isBuy = false;          // Side of the incoming order
+    OrderId orderId = 0;         // Incoming order (buy order for trades)
+    OrderId otherOrderId = 0;    // Sell order for trades
+    TraderId traderId = 0;
+    TraderId otherTraderId = 0;
+    Price price;
+    Price bestPrice;
+    Qty quantity;
+    Qty remaining;
+};
+
+// Asynchronous event logger.
+// log() copies a record into a lock-free ring buffer; a background thread
+// formats the records and writes them to the output stream in batches, so the
+// caller never formats text or flushes a stream. Each line is formatted in a
+// buffer the logger owns and only the finished bytes reach the output stream,
+// whose formatting state is never touched. When the ring is full, log()
+// waits for the writer rather than dropping events.
+class EventLogger {
+public:
+    explicit EventLogger(std::ostream& out = std::cout, std::size_t capacity = 8192);
+    ~EventLogger();
+
+    EventLogger(const EventLogger&) = delete;
+    EventLogger& operator=(const EventLogger&) = delete;
+
+    // Queue an event
+    void log(const LogEvent& event) {
+        while (!queue.tryPush(event)) {
+            stalls.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+        logged.fetch_add(1, std::memory_order_release);
+    }
+
+    // Block until every event queued so far has been written and flushed
+    void flush() const;
+
+    // Number of times log() found the ring full
+    std::uint64_t getStalls() const;
+
+private:
+    std::ostream& out;
+    BoundedQueue<LogEvent> queue;
+    std::atomic<std::uint64_t> logged{0};   // Events queued
+    std::atomic<std::uint64_t> written{0};  // Events written and flushed
+    std::atomic<std::uint64_t> stalls{0};
+    std::atomic<bool> stopping{false};
+    std::ostringstream line;  // Writer thread only
+    std::thread worker;
+
+    // Background loop: drain, write, flush, sleep
+    void run();
+
+    // Format one event as a log line and write it out
+    void write(const LogEvent& event);
+};
+
+}
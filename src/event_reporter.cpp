@@ -0,0 +1,48 @@
+#include "event_reporter.hpp"
+
+namespace trading {
+
+// Append to the file named by TRADING_JOURNAL_PATH
+BinaryJournal::BinaryJournal()
+    : file(std::make_unique<std::ofstream>(TRADING_JOURNAL_PATH, std::ios::binary | std::ios::app)),
+      out(file.get()) {
+    buffer.reserve(BLOCK_EVENTS);
+}
+
+// Write to a caller-owned stream
+BinaryJournal::BinaryJournal(std::ostream& out): out(&out) {
+    buffer.reserve(BLOCK_EVENTS);
+}
+
+// Destructor: write whatever is still buffered
+BinaryJournal::~BinaryJournal() {
+    flush();
+}
+
+// Write buffered records to the stream
+void BinaryJournal::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    writeBuffer();
+    out->flush();
+}
+
+// Write buffered records in one block
+void BinaryJournal::writeBuffer() {
+    if (!buffer.empty()) {
+        out->write(reinterpret_cast<const char*>(buffer.data()),
+                   static_cast<std::streamsize>(buffer.size() * sizeof(LogEvent)));
+        buffer.clear();
+    }
+}
+
+// Read back every record in a journal
+std::vector<LogEvent> BinaryJournal::read(std::istream& in) {
+    std::vector<LogEvent> events;
+    LogEvent event;
+    while (in.read(reinterpret_cast<char*>(&event), sizeof(LogEvent))) {
+        events.push_back(event);
+    }
+    return events;
+}
+
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "event_logger.hpp"
+#include "order.hpp"
+#include "trade.hpp"
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#ifndef TRADING_JOURNAL_PATH
+#define TRADING_JOURNAL_PATH "exchange_journal.bin"
+#endif
+
+namespace trading {
+
+// Reporters receive every exchange event through the same set of calls.
+// Exchange picks one at compile time (see Exchange::Reporter), so a build
+// with NullReporter compiles every reporting call, and the record it would
+// have built, away.
+
+// Build the record shared by every event about an incoming order
+inline LogEvent makeOrderEvent(EventType type, const Order& order) {
+    LogEvent event;
+    event.type = type;
+    event.isBuy = order.isBuyOrder();
+    event.orderId = order.getId();
+    event.traderId = order.getTraderId();
+    event.timestamp = order.getTimestamp();
+    return event;
+}
+
+// Turns each event into a LogEvent record and hands it to Derived::record
+template <typename Derived>
+class RecordReporter {
+public:
+    // Trade executed
+    void trade(const Trade& trade) {
+        LogEvent event;
+        event.type = EventType::TRADE;
+        event.isBuy = true;
+        event.orderId = trade.buyOrderId;
+        event.otherOrderId = trade.sellOrderId;
+        event.traderId = trade.buyTraderId;
+        event.otherTraderId = trade.sellTraderId;
+        event.price = trade.price;
+        event.quantity = trade.quantity;
+        event.timestamp = trade.timestamp;
+        self().record(event);
+    }
+
+    // Opposite side empty
+    void noMatch(const Order& order) {
+        self().record(makeOrderEvent(EventType::NO_MATCH, order));
+    }
+
+    // Limit price does not cross the best opposite price
+    void rested(const Order& order, Price bestPrice) {
+        LogEvent event = makeOrderEvent(EventType::RESTED, order);
+        event.price = order.getPrice();
+        event.bestPrice = bestPrice;
+        self().record(event);
+    }
+
+    // Incoming order fully executed
+    void complete(const Order& order, Qty initialQuantity) {
+        LogEvent event = makeOrderEvent(EventType::COMPLETE, order);
+        event.quantity = initialQuantity;
+        self().record(event);
+    }
+
+    // Incoming order partly executed
+    void partial(const Order& order, Qty filled) {
+        LogEvent event = makeOrderEvent(EventType::PARTIAL, order);
+        event.quantity = filled;
+        event.remaining = order.getQuantity();
+        self().record(event);
+    }
+
+    // Immediate order's unfilled quantity cancelled instead of resting
+    void cancelled(const Order& order) {
+        LogEvent event = makeOrderEvent(EventType::CANCELLED, order);
+        event.price = order.getPrice();
+        event.remaining = order.getQuantity();
+        self().record(event);
+    }
+
+    // Incoming order reduced instead of trading with its own trader
+    void selfTradePrevented(const Order& order, Qty prevented) {
+        LogEvent event = makeOrderEvent(EventType::SELF_TRADE_PREVENTED, order);
+        event.quantity = prevented;
+        event.remaining = order.getQuantity();
+        self().record(event);
+    }
+
+    // Trader joined the exchange
+    void traderRegistered(TraderId traderId) {
+        LogEvent event;
+        event.type = EventType::TRADER_REGISTERED;
+        event.traderId = traderId;
+        event.timestamp = monotonicNanos();
+        self().record(event);
+    }
+
+private:
+    Derived& self() {
+        return static_cast<Derived&>(*this);
+    }
+};
+
+// Human-readable log lines, formatted off-thread by an EventLogger
+class TextReporter : public RecordReporter<TextReporter> {
+public:
+    explicit TextReporter(std::ostream& out = std::cout): logger(out) {
+    }
+
+    void record(const LogEvent& event) {
+        logger.log(event);
+    }
+
+    // Wait until every event so far has been written
+    void flush() {
+        logger.flush();
+    }
+
+private:
+    EventLogger logger;
+};
+
+// Raw LogEvent records appended to a binary journal, written in blocks.
+// Records are appended under a mutex so shard threads can share one journal.
+class BinaryJournal : public RecordReporter<BinaryJournal> {
+public:
+    static constexpr std::size_t BLOCK_EVENTS = 4096;
+
+    // Append to the file named by TRADING_JOURNAL_PATH
+    BinaryJournal();
+
+    // Write to a caller-owned stream
+    explicit BinaryJournal(std::ostream& out);
+
+    ~BinaryJournal();
+
+    BinaryJournal(const BinaryJournal&) = delete;
+    BinaryJournal& operator=(const BinaryJournal&) = delete;
+
+    void record(const LogEvent& event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffer.push_back(event);
+        if (buffer.size() == BLOCK_EVENTS) {
+            writeBuffer();
+        }
+    }
+
+    // Write buffered records to the stream
+    void flush();
+
+    // Read back every record in a journal
+    static std::vector<LogEvent> read(std::istream& in);
+
+private:
+    std::unique_ptr<std::ofstream> file;  // Only set when the journal owns its file
+    std::ostream* out;
+    std::vector<LogEvent> buffer;
+    std::mutex mutex;
+
+    // Write buffered records in one block (caller holds the mutex)
+    void writeBuffer();
+};
+
+// Reports nothing; every call is an empty inline function
+class NullReporter {
+public:
+    void trade(const Trade&) {}
+    void noMatch(const Order&) {}
+    void rested(const Order&, Price) {}
+    void complete(const Order&, Qty) {}
+    void partial(const Order&, Qty) {}
+    void cancelled(const Order&) {}
+    void selfTradePrevented(const Order&, Qty) {}
+    void traderRegistered(TraderId) {}
+    void flush() {}
+};
+
+static_assert(std::is_trivially_copyable_v<LogEvent>, "journal records are written as raw bytes");
+
+}
@@ -3,194 +3,146 @@
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
-#include <chrono>
-#include <ctime>
+#include <thread>
 
 namespace trading {
 
 // Get current local time with millisecond detail
 std::string getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t_now = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                  now.time_since_epoch()) % 1000;
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t_now), "%Y-%m-%d %H:%M:%S")
-       << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    return ss.str();
+    return formatTimestamp(monotonicNanos());
 }
 
 // Format trade details as a log string
 std::string Trade::toString() const {
     std::stringstream ss;
     ss << std::fixed << std::setprecision(2);
-    ss << "[" << getCurrentTimestamp() << "] TRADE EXECUTED: "
+    ss << "[" << formatTimestamp(timestamp) << "] TRADE EXECUTED: "
        << quantity << " units at $" << price
-       << " | Buyer: " << buyTraderId
-       << " (Order " << buyOrderId << ")"
-       << " | Seller: " << sellTraderId
-       << " (Order " << sellOrderId << ")";
+       << " | Buyer: " << formatTraderId(buyTraderId)
+       << " (Order " << formatOrderId(buyOrderId) << ")"
+       << " | Seller: " << formatTraderId(sellTraderId)
+       << " (Order " << formatOrderId(sellOrderId) << ")";
     return ss.str();
 }
 
+// Add another set of totals
+ExchangeStats& ExchangeStats::operator+=(const ExchangeStats& other) {
+    ordersSubmitted += other.ordersSubmitted;
+    ordersRested += other.ordersRested;
+    ordersRejected += other.ordersRejected;
+    stopsHeld += other.stopsHeld;
+    tradesExecuted += other.tradesExecuted;
+    batchesSubmitted += other.batchesSubmitted;
+    auctionsUncrossed += other.auctionsUncrossed;
+    volumeTraded += other.volumeTraded;
+    return *this;
+}
+
+// Constructor: one shard per listed symbol (at least the default one)
+Exchange::Exchange(SymbolId symbolCount): orderPool(OrderPool::create()) {
+    symbolCount = std::max<SymbolId>(symbolCount, 1);
+    shards.reserve(symbolCount);
+    for (SymbolId symbol = 0; symbol < symbolCount; ++symbol) {
+        shards.push_back(std::make_unique<Shard>());
+        shards.back()->symbol = symbol;
+    }
+}
+
+// Shard for a symbol (nullptr if the symbol is not listed)
+Shard* Exchange::findShard(SymbolId symbol) {
+    return symbol < shards.size() ? shards[symbol].get() : nullptr;
+}
+
+// Destructor: orders still held elsewhere keep the pool alive until destroyed
+Exchange::~Exchange() {
+    orderPool->release();
+}
+
 // Match an incoming order against the order book
-std::vector<Trade> Exchange::matchOrder(std::shared_ptr<Order> incomingOrder)
+std::size_t Exchange::matchOrder(Shard& shard, Order& incoming, TradeSink* sink, ExchangeStats& tally)
 {
-    std::vector<Trade> executedTrades;
-    double initialQuantity = incomingOrder->getQuantity();
-    std::string incomingTraderId = incomingOrder->getTraderId();
-
-    // Buy side
-    if (incomingOrder->isBuyOrder()) {
-        while (incomingOrder->getQuantity() > 0) {
-            auto bestAsk = orderBook.getLowestAsk();
-            if (!bestAsk || bestAsk->getQuantity() <= 0) {
-                std::cout << "[" << getCurrentTimestamp() << "] ORDER STATUS: Buy order "
-                          << incomingOrder->getId() << " (Trader " << incomingTraderId
-                          << ") - No matching sell orders available" << std::endl;
-                break;
-            }
+    std::size_t tradeCount = 0;
+    Qty initialQuantity = incoming.getQuantity();
+    bool isBuy = incoming.isBuyOrder();
 
-            // Check crossing for limit orders
-            if (incomingOrder->getType() == OrderType::LIMIT) {
-                double incomingPrice = incomingOrder->getPrice();
-                double bestAskPrice = bestAsk->getPrice();
-                if (incomingPrice < bestAskPrice) {
-                    std::cout << "[" << getCurrentTimestamp() << "] ORDER STATUS: Buy limit order "
-                              << incomingOrder->getId() << " (Trader " << incomingTraderId
-                              << ") - Price $" << incomingPrice
-                              << " below best ask $" << bestAskPrice
-                              << " - Order added to book" << std::endl;
-                    break;
-                }
-            }
+    // Market orders take any price on the opposite side
+    OrderType type = incoming.getType();
+    Price limit = incoming.getPrice();
+    if (type == OrderType::MARKET) {
+        limit = isBuy ? Price::max() : Price::min();
+    }
 
-            // Determine matched quantity
-            double matchedQty = std::min(incomingOrder->getQuantity(), bestAsk->getQuantity());
-
-            // Create and log trade
-            Trade trade;
-            trade.buyOrderId = incomingOrder->getId();
-            trade.sellOrderId = bestAsk->getId();
-            trade.buyTraderId = incomingOrder->getTraderId();
-            trade.sellTraderId = bestAsk->getTraderId();
-            trade.price = bestAsk->getPrice();
-            trade.quantity = matchedQty;
-            executedTrades.push_back(trade);
-            std::cout << trade.toString() << std::endl;
-
-            // Update quantities
-            double newIncomingQty = incomingOrder->getQuantity() - matchedQty;
-            double newAskQty = bestAsk->getQuantity() - matchedQty;
-            incomingOrder->setQuantity(newIncomingQty);
-            bestAsk->setQuantity(newAskQty);
-
-            // Remove fully filled ask
-            if (newAskQty <= 0) {
-                bool removed = orderBook.removeOrder(bestAsk->getId());
-                if (!removed) {
-                    std::cout << "[" << getCurrentTimestamp() << "] ERROR: Failed to remove sell order "
-                              << bestAsk->getId() << std::endl;
-                    break;
-                }
-            }
+    // Fill-or-kill: reject from level totals before touching any order,
+    // not counting what self-trade prevention would keep it from filling
+    if (type == OrderType::FOK &&
+        shard.book.getCrossingDepth(isBuy, limit, initialQuantity, incoming.getTraderId(), selfTradePrevention) < initialQuantity) {
+        reporter.cancelled(incoming);
+        return 0;
+    }
+
+    // Sweep the opposite side, recording a trade at the resting price per fill
+    Qty filled = shard.book.match(incoming, limit, [&](const Order& resting, Price price, Qty quantity) {
+        Trade trade;
+        trade.symbol = incoming.getSymbol();
+        trade.buyOrderId = isBuy ? incoming.getId() : resting.getId();
+        trade.sellOrderId = isBuy ? resting.getId() : incoming.getId();
+        trade.buyTraderId = isBuy ? incoming.getTraderId() : resting.getTraderId();
+        trade.sellTraderId = isBuy ? resting.getTraderId() : incoming.getTraderId();
+        trade.price = price;
+        trade.quantity = quantity;
+        trade.aggressorIsBuy = isBuy;
+        trade.timestamp = incoming.getTimestamp();
+        shard.trades.append(trade);
+        shard.lastTradePrice = price;
+        reporter.trade(trade);
+        if (sink) {
+            sink->onTrade(trade);
         }
+        ++tradeCount;
+    }, selfTradePrevention);
+    tally.tradesExecuted += tradeCount;
+    tally.volumeTraded += filled;
 
-        // Log final outcome
-        if (incomingOrder->getQuantity() <= 0) {
-            std::cout << "[" << getCurrentTimestamp() << "] ORDER COMPLETE: Buy order "
-                      << incomingOrder->getId() << " (Trader " << incomingTraderId
-                      << ") fully executed for " << initialQuantity << " units" << std::endl;
-        } else if (incomingOrder->getQuantity() < initialQuantity) {
-            std::cout << "[" << getCurrentTimestamp() << "] ORDER PARTIAL: Buy order "
-                      << incomingOrder->getId() << " (Trader " << incomingTraderId
-                      << ") " << (initialQuantity - incomingOrder->getQuantity())
-                      << " filled, " << incomingOrder->getQuantity() << " remaining" << std::endl;
+    // Report why matching stopped, then the final outcome
+    if (incoming.getQuantity() > Qty()) {
+        BookTop opposite = isBuy ? shard.book.getTopOfBook().ask : shard.book.getTopOfBook().bid;
+        if (opposite.orderCount == 0) {
+            reporter.noMatch(incoming);
+        } else if (type == OrderType::LIMIT) {
+            reporter.rested(incoming, opposite.price);
         }
     }
-    // Sell side
-    else {
-        while (incomingOrder->getQuantity() > 0) {
-            auto bestBid = orderBook.getHighestBid();
-            if (!bestBid || bestBid->getQuantity() <= 0) {
-                std::cout << "[" << getCurrentTimestamp() << "] ORDER STATUS: Sell order "
-                          << incomingOrder->getId() << " (Trader " << incomingTraderId
-                          << ") - No matching buy orders available" << std::endl;
-                break;
-            }
-
-            // Check crossing for limit orders
-            if (incomingOrder->getType() == OrderType::LIMIT) {
-                double incomingPrice = incomingOrder->getPrice();
-                double bestBidPrice = bestBid->getPrice();
-                if (bestBidPrice < incomingPrice) {
-                    std::cout << "[" << getCurrentTimestamp() << "] ORDER STATUS: Sell limit order "
-                              << incomingOrder->getId() << " (Trader " << incomingTraderId
-                              << ") - Price $" << incomingPrice
-                              << " above best bid $" << bestBidPrice
-                              << " - Order added to book" << std::endl;
-                    break;
-                }
-            }
+    if (filled == initialQuantity) {
+        reporter.complete(incoming, initialQuantity);
+    } else if (filled > Qty()) {
+        reporter.partial(incoming, filled);
+    }
 
-            // Determine matched quantity
-            double matchedQty = std::min(incomingOrder->getQuantity(), bestBid->getQuantity());
-
-            // Create and log trade
-            Trade trade;
-            trade.buyOrderId = bestBid->getId();
-            trade.sellOrderId = incomingOrder->getId();
-            trade.buyTraderId = bestBid->getTraderId();
-            trade.sellTraderId = incomingOrder->getTraderId();
-            trade.price = bestBid->getPrice();
-            trade.quantity = matchedQty;
-            executedTrades.push_back(trade);
-            std::cout << trade.toString() << std::endl;
-
-            // Update quantities
-            double newIncomingQty = incomingOrder->getQuantity() - matchedQty;
-            double newBidQty = bestBid->getQuantity() - matchedQty;
-            incomingOrder->setQuantity(newIncomingQty);
-            bestBid->setQuantity(newBidQty);
-
-            // Remove fully filled bid
-            if (newBidQty <= 0) {
-                bool removed = orderBook.removeOrder(bestBid->getId());
-                if (!removed) {
-                    std::cout << "[" << getCurrentTimestamp() << "] ERROR: Failed to remove buy order "
-                              << bestBid->getId() << std::endl;
-                    break;
-                }
-            }
-        }
+    // Quantity taken off the incoming order to avoid trading with its own trader
+    Qty prevented = initialQuantity - filled - incoming.getQuantity();
+    if (prevented > Qty()) {
+        reporter.selfTradePrevented(incoming, prevented);
+    }
 
-        // Log final outcome
-        if (incomingOrder->getQuantity() <= 0) {
-            std::cout << "[" << getCurrentTimestamp() << "] ORDER COMPLETE: Sell order "
-                      << incomingOrder->getId() << " (Trader " << incomingTraderId
-                      << ") fully executed for " << initialQuantity << " units" << std::endl;
-        } else if (incomingOrder->getQuantity() < initialQuantity) {
-            std::cout << "[" << getCurrentTimestamp() << "] ORDER PARTIAL: Sell order "
-                      << incomingOrder->getId() << " (Trader " << incomingTraderId
-                      << ") " << (initialQuantity - incomingOrder->getQuantity())
-                      << " filled, " << incomingOrder->getQuantity() << " remaining" << std::endl;
-        }
+    // Immediate orders never rest; what is left is cancelled
+    if (type == OrderType::IOC && incoming.getQuantity() > Qty()) {
+        reporter.cancelled(incoming);
     }
 
-    return executedTrades;
+    return tradeCount;
 }
 
 // Register a new Trader and log the event
 std::shared_ptr<Trader> Exchange::registerTrader() {
     auto trader = std::make_shared<Trader>(this);
     traders[trader->getId()] = trader;
-    std::cout << "[" << getCurrentTimestamp() << "] TRADER REGISTERED: "
-              << trader->getId() << std::endl;
+    reporter.traderRegistered(trader->getId());
     return trader;
 }
 
 // Print all registered traders
 void Exchange::displayTraders() const {
+    flushLog();
     std::cout << "[" << getCurrentTimestamp() << "] REGISTERED TRADERS:\n"
               << "=============================\n";
     if (traders.empty()) {
@@ -198,51 +150,410 @@ void Exchange::displayTraders() const {
         return;
     }
     for (const auto& [traderId, trader] : traders) {
-        std::cout << "Trader ID: " << traderId << std::endl;
+        std::cout << "Trader ID: " << formatTraderId(traderId) << std::endl;
     }
     std::cout << "Total traders: " << traders.size() << std::endl;
 }
 
 // Submit an order: try to match, then add leftover limit order to the book
+std::size_t Exchange::execute(std::shared_ptr<Order> order, TradeSink* sink, ExchangeStats& tally) {
+    Shard* shard = findShard(order->getSymbol());
+    if (!shard) {
+        ++tally.ordersRejected;
+        return 0;
+    }
+
+    // Stops wait in the index unless the last trade has already reached them
+    OrderType type = order->getType();
+    if (type == OrderType::STOP || type == OrderType::STOP_LIMIT) {
+        auto& condition = dynamic_cast<StopCondition&>(*order);
+        if (shard->lastTradePrice == Price() || !condition.isReachedBy(shard->lastTradePrice, order->isBuyOrder())) {
+            order->setTimestamp(monotonicNanos());
+            ++tally.stopsHeld;
+            shard->stops.add(std::move(order));
+            return 0;
+        }
+        condition.trigger();
+    }
+
+    std::size_t tradeCount = place(*shard, std::move(order), sink, tally);
+    if (tradeCount > 0) {
+        tradeCount += releaseStops(*shard, sink, tally);
+    }
+    return tradeCount;
+}
+
+// Release the stops the last trade reached; their own trades may reach
+// more, which are appended and handled in the same pass
+std::size_t Exchange::releaseStops(Shard& shard, TradeSink* sink, ExchangeStats& tally) {
+    if (shard.stops.empty()) {
+        return 0;
+    }
+    std::size_t tradeCount = 0;
+    std::vector<std::shared_ptr<Order>> released;
+    shard.stops.release(shard.lastTradePrice, released);
+    for (std::size_t i = 0; i < released.size(); ++i) {
+        std::size_t stopTrades = place(shard, std::move(released[i]), sink, tally);
+        tradeCount += stopTrades;
+        if (stopTrades > 0) {
+            shard.stops.release(shard.lastTradePrice, released);
+        }
+    }
+    return tradeCount;
+}
+
+// Match an order and rest what is left of a limit order (or collect it if an auction is open)
+std::size_t Exchange::place(Shard& shard, std::shared_ptr<Order> order, TradeSink* sink, ExchangeStats& tally) {
+    if (shard.auctionOpen) {
+        collectOrder(shard, std::move(order), tally);
+        return 0;
+    }
+
+    // One clock read per submission; every trade it causes shares the stamp
+    order->setTimestamp(monotonicNanos());
+    std::size_t tradeCount = matchOrder(shard, *order, sink, tally);
+
+    ++tally.ordersSubmitted;
+    if (order->getType() == OrderType::LIMIT && order->getQuantity() > Qty()) {
+        shard.book.addOrder(std::move(order));
+        ++tally.ordersRested;
+    }
+    return tradeCount;
+}
+
+// Submit an order and return its trades
 std::vector<Trade> Exchange::submitOrder(std::shared_ptr<Order> order) {
-    std::vector<Trade> newTrades = matchOrder(order);
-    if (order->getType() == OrderType::LIMIT && order->getQuantity() > 0) {
-        orderBook.addOrder(order);
+    std::vector<Trade> newTrades;
+    VectorTradeSink sink(newTrades);
+    execute(std::move(order), &sink, stats);
+    return newTrades;
+}
+
+// Submit an order, streaming its trades to a caller-supplied sink
+std::size_t Exchange::submitOrder(std::shared_ptr<Order> order, TradeSink& sink) {
+    return execute(std::move(order), &sink, stats);
+}
+
+// Submit a batch and return all of its trades
+std::vector<Trade> Exchange::submitOrders(std::span<const std::shared_ptr<Order>> orders) {
+    std::vector<Trade> newTrades;
+    newTrades.reserve(orders.size());
+    VectorTradeSink sink(newTrades);
+    submitOrders(orders, sink);
+    return newTrades;
+}
+
+// Submit a batch, streaming its trades to a caller-supplied sink
+std::size_t Exchange::submitOrders(std::span<const std::shared_ptr<Order>> orders, TradeSink& sink) {
+    if (shards.size() == 1) {
+        shards[0]->trades.reserve(orders.size());
+    }
+    ExchangeStats batch;
+    std::size_t tradeCount = 0;
+    for (const auto& order : orders) {
+        if (order) {
+            tradeCount += execute(order, &sink, batch);
+        }
+    }
+    ++batch.batchesSubmitted;
+    stats += batch;
+    return tradeCount;
+}
+
+// Submit a batch, matching each symbol's orders on one of several threads
+std::size_t Exchange::submitOrdersParallel(std::span<const std::shared_ptr<Order>> orders, std::size_t maxThreads) {
+    // Bucket orders by symbol, keeping their sequence within each symbol
+    ExchangeStats batch;
+    std::vector<std::vector<std::shared_ptr<Order>>> buckets(shards.size());
+    for (const auto& order : orders) {
+        if (!order) {
+            continue;
+        }
+        if (order->getSymbol() >= shards.size()) {
+            ++batch.ordersRejected;
+            continue;
+        }
+        buckets[order->getSymbol()].push_back(order);
+    }
+
+    std::vector<SymbolId> active;
+    for (SymbolId symbol = 0; symbol < buckets.size(); ++symbol) {
+        if (!buckets[symbol].empty()) {
+            active.push_back(symbol);
+        }
+    }
+    if (maxThreads == 0) {
+        maxThreads = std::max(1u, std::thread::hardware_concurrency());
     }
-    trades.insert(trades.end(), newTrades.begin(), newTrades.end());
+    std::size_t threadCount = std::min(maxThreads, active.size());
+
+    // Thread t owns every threadCount-th active shard, so a shard never has two writers
+    struct alignas(64) WorkerTally {
+        ExchangeStats stats;
+        std::size_t trades = 0;
+    };
+    std::vector<WorkerTally> tallies(threadCount);
+    auto work = [&](std::size_t t) {
+        for (std::size_t i = t; i < active.size(); i += threadCount) {
+            auto& bucket = buckets[active[i]];
+            shards[active[i]]->trades.reserve(bucket.size());
+            for (auto& order : bucket) {
+                tallies[t].trades += execute(std::move(order), nullptr, tallies[t].stats);
+            }
+        }
+    };
+
+    // The calling thread takes the first stripe
+    std::vector<std::thread> workers;
+    for (std::size_t t = 1; t < threadCount; ++t) {
+        workers.emplace_back(work, t);
+    }
+    if (threadCount > 0) {
+        work(0);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::size_t tradeCount = 0;
+    for (const WorkerTally& tally : tallies) {
+        batch += tally.stats;
+        tradeCount += tally.trades;
+    }
+    ++batch.batchesSubmitted;
+    stats += batch;
+    return tradeCount;
+}
+
+// Add an order to an open auction: limits rest without matching, market
+// orders wait for the uncross, immediate orders cannot be held so are rejected
+void Exchange::collectOrder(Shard& shard, std::shared_ptr<Order> order, ExchangeStats& tally) {
+    order->setTimestamp(monotonicNanos());
+    switch (order->getType()) {
+        case OrderType::LIMIT:
+            ++tally.ordersSubmitted;
+            shard.book.addOrder(std::move(order));
+            ++tally.ordersRested;
+            break;
+        case OrderType::MARKET:
+            ++tally.ordersSubmitted;
+            shard.auctionMarketOrders.push_back(std::move(order));
+            break;
+        default:
+            ++tally.ordersRejected;
+            reporter.cancelled(*order);
+            break;
+    }
+}
+
+// Uncross at the clearing price: each side fills in price-time priority
+// (market orders first), and the fills are paired off into trades
+std::size_t Exchange::uncross(Shard& shard, TradeSink* sink) {
+    Qty marketBuys;
+    Qty marketSells;
+    for (const auto& order : shard.auctionMarketOrders) {
+        (order->isBuyOrder() ? marketBuys : marketSells) += order->getQuantity();
+    }
+    AuctionClearing clearing = shard.book.getClearingPrice(marketBuys, marketSells);
+
+    // Collect each side's fills, market orders ahead of the book
+    struct AuctionFill {
+        OrderId orderId;
+        TraderId traderId;
+        Qty quantity;
+    };
+    std::vector<AuctionFill> buys;
+    std::vector<AuctionFill> sells;
+    Qty buyLeft = clearing.volume;
+    Qty sellLeft = clearing.volume;
+    for (const auto& order : shard.auctionMarketOrders) {
+        Qty& left = order->isBuyOrder() ? buyLeft : sellLeft;
+        Qty take = std::min(left, order->getQuantity());
+        if (take > Qty()) {
+            (order->isBuyOrder() ? buys : sells).push_back(AuctionFill{order->getId(), order->getTraderId(), take});
+            order->setQuantity(order->getQuantity() - take);
+            left -= take;
+        }
+    }
+    shard.book.sweep(true, clearing.price, buyLeft, [&](const Order& resting, Price, Qty quantity) {
+        buys.push_back(AuctionFill{resting.getId(), resting.getTraderId(), quantity});
+    });
+    shard.book.sweep(false, clearing.price, sellLeft, [&](const Order& resting, Price, Qty quantity) {
+        sells.push_back(AuctionFill{resting.getId(), resting.getTraderId(), quantity});
+    });
+
+    // Pair the fills off in priority order, all at the clearing price
+    Timestamp now = monotonicNanos();
+    std::size_t tradeCount = 0;
+    std::size_t b = 0;
+    std::size_t s = 0;
+    while (b < buys.size() && s < sells.size()) {
+        Qty quantity = std::min(buys[b].quantity, sells[s].quantity);
+        Trade trade;
+        trade.symbol = shard.symbol;
+        trade.buyOrderId = buys[b].orderId;
+        trade.sellOrderId = sells[s].orderId;
+        trade.buyTraderId = buys[b].traderId;
+        trade.sellTraderId = sells[s].traderId;
+        trade.price = clearing.price;
+        trade.quantity = quantity;
+        trade.timestamp = now;
+        shard.trades.append(trade);
+        reporter.trade(trade);
+        if (sink) {
+            sink->onTrade(trade);
+        }
+        ++tradeCount;
+
+        buys[b].quantity -= quantity;
+        sells[s].quantity -= quantity;
+        if (buys[b].quantity <= Qty()) ++b;
+        if (sells[s].quantity <= Qty()) ++s;
+    }
+
+    // Market orders do not carry over to the next interval
+    for (const auto& order : shard.auctionMarketOrders) {
+        if (order->getQuantity() > Qty()) {
+            reporter.cancelled(*order);
+        }
+    }
+    shard.auctionMarketOrders.clear();
+
+    ++stats.auctionsUncrossed;
+    stats.tradesExecuted += tradeCount;
+    stats.volumeTraded += clearing.volume;
+
+    // The clearing price is the last trade price, so it can release stops
+    // (collected for the next uncross if the auction stays open)
+    if (clearing.volume > Qty()) {
+        shard.lastTradePrice = clearing.price;
+        tradeCount += releaseStops(shard, sink, stats);
+    }
+    return tradeCount;
+}
+
+// Start collecting a symbol's orders for a call auction
+void Exchange::openAuction(SymbolId symbol) {
+    shards.at(symbol)->auctionOpen = true;
+}
+
+// Uncross a symbol's auction and return its trades
+std::vector<Trade> Exchange::uncrossAuction(SymbolId symbol) {
+    std::vector<Trade> newTrades;
+    VectorTradeSink sink(newTrades);
+    uncrossAuction(symbol, sink);
     return newTrades;
 }
 
+// Uncross a symbol's auction, streaming its trades to a sink
+std::size_t Exchange::uncrossAuction(SymbolId symbol, TradeSink& sink) {
+    return uncross(*shards.at(symbol), &sink);
+}
+
+// Uncross one last time and resume continuous matching (so stops released
+// by the final clearing price match straight away)
+std::vector<Trade> Exchange::closeAuction(SymbolId symbol) {
+    shards.at(symbol)->auctionOpen = false;
+    return uncrossAuction(symbol);
+}
+
+// Whether a symbol is collecting orders for an auction
+bool Exchange::isAuctionOpen(SymbolId symbol) const {
+    return shards.at(symbol)->auctionOpen;
+}
+
 // Cancel an existing order by ID
-bool Exchange::cancelOrder(const std::string& orderId) {
-    return orderBook.removeOrder(orderId);
+bool Exchange::cancelOrder(OrderId orderId) {
+    return cancelOrder(0, orderId);
+}
+
+bool Exchange::cancelOrder(SymbolId symbol, OrderId orderId) {
+    Shard* shard = findShard(symbol);
+    return shard && (shard->book.removeOrder(orderId) || shard->stops.remove(orderId));
+}
+
+// Modify limit order price/quantity. A size decrease at the same price
+// amends the resting order in place and keeps its time priority; any other
+// change requeues the order behind everything at its new price.
+bool Exchange::modifyOrder(OrderId orderId, Price newPrice, Qty newQuantity) {
+    return modifyOrder(0, orderId, newPrice, newQuantity);
+}
+
+bool Exchange::modifyOrder(SymbolId symbol, OrderId orderId, Price newPrice, Qty newQuantity) {
+    return modifyOrder(symbol, orderId, newPrice, newQuantity, nullptr);
+}
+
+bool Exchange::modifyOrder(SymbolId symbol, OrderId orderId, Price newPrice, Qty newQuantity, TradeSink& sink) {
+    return modifyOrder(symbol, orderId, newPrice, newQuantity, &sink);
 }
 
-// Modify limit order price/quantity, then resubmit it
-bool Exchange::modifyOrder(const std::string& orderId, double newPrice, double newQuantity) {
+bool Exchange::modifyOrder(SymbolId symbol, OrderId orderId, Price newPrice, Qty newQuantity, TradeSink* sink) {
+    Shard* shard = findShard(symbol);
+    if (!shard) return false;
+    OrderBook& orderBook = shard->book;
+    Order* resting = orderBook.tryFindOrder(orderId).value;
+    if (!resting) return false;
+    if (resting->getType() != OrderType::LIMIT) return false;
+    if (newQuantity <= Qty() || newPrice <= Price()) return false;
+
+    // Same price: shrink in place, or nothing to do (sizes include any iceberg reserve)
+    if (newPrice == resting->getPrice()) {
+        if (newQuantity == resting->getTotalQuantity()) return true;
+        if (newQuantity < resting->getTotalQuantity()) {
+            return orderBook.reduceQuantity(orderId, newQuantity) == BookStatus::OK;
+        }
+    }
+
+    // Keep the order alive while it is out of the book
     auto existingOrder = orderBook.findOrder(orderId);
-    if (!existingOrder) return false;
-    if (existingOrder->getType() != OrderType::LIMIT) return false;
-    if (newQuantity <= 0 || newPrice <= 0) return false;
     if (!orderBook.removeOrder(orderId)) return false;
 
-    existingOrder->setQuantity(newQuantity);
+    existingOrder->setTotalQuantity(newQuantity);
     auto limitPtr = std::dynamic_pointer_cast<LimitOrder>(existingOrder);
     if (!limitPtr) return false;
     limitPtr->setPrice(newPrice);
 
-    submitOrder(existingOrder);
+    execute(std::move(existingOrder), sink, stats);
     return true;
 }
 
-// Return a const reference to the OrderBook
-const OrderBook& Exchange::getOrderBook() const {
-    return orderBook;
+// Choose how orders from the same trader are kept from trading together
+void Exchange::setSelfTradePrevention(SelfTradePrevention mode) {
+    selfTradePrevention = mode;
+}
+
+SelfTradePrevention Exchange::getSelfTradePrevention() const {
+    return selfTradePrevention;
+}
+
+// Number of listed symbols
+SymbolId Exchange::getSymbolCount() const {
+    return static_cast<SymbolId>(shards.size());
+}
+
+// Return a const reference to a symbol's OrderBook
+const OrderBook& Exchange::getOrderBook(SymbolId symbol) const {
+    return shards.at(symbol)->book;
+}
+
+// Return the order pool backing createOrder
+const OrderPool& Exchange::getOrderPool() const {
+    return *orderPool;
+}
+
+// Return activity totals
+const ExchangeStats& Exchange::getStats() const {
+    return stats;
+}
+
+// Wait until every reported event has been written
+void Exchange::flushLog() const {
+    reporter.flush();
 }
 
-// Return the vector of all executed trades
-const std::vector<Trade>& Exchange::getTrades() const {
-    return trades;
+// Return the store of a symbol's executed trades
+const TradeStore& Exchange::getTrades(SymbolId symbol) const {
+    return shards.at(symbol)->trades;
 }
 
 }
\ No newline at end of file
@@ -1,37 +1,108 @@
 #pragma once
 
+#include "event_reporter.hpp"
 #include "order_book.hpp"
+#include "order_pool.hpp"
+#include "stop_index.hpp"
+#include "trade.hpp"
+#include "trade_sink.hpp"
+#include "trade_store.hpp"
 #include "trader.hpp"
 #include <string>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 #include <unordered_map>
 
 namespace trading {
 
-// Trade struct
-struct Trade {
-    std::string buyOrderId;
-    std::string sellOrderId;
-    std::string buyTraderId;   
-    std::string sellTraderId;  
-    double price;
-    double quantity;
+// Running totals of exchange activity
+struct ExchangeStats {
+    std::uint64_t ordersSubmitted = 0;    // Orders matched or collected (stops once triggered)
+    std::uint64_t ordersRested = 0;     // Limit orders left in the book after matching
+    std::uint64_t ordersRejected = 0;   // Orders for a symbol the exchange does not list
+    std::uint64_t stopsHeld = 0;        // Stop orders placed in the trigger index
+    std::uint64_t tradesExecuted = 0;
+    std::uint64_t batchesSubmitted = 0;
+    std::uint64_t auctionsUncrossed = 0;
+    Qty volumeTraded;
 
-    std::string toString() const;
+    ExchangeStats& operator+=(const ExchangeStats& other);
+};
+
+// One instrument: its book and its trade record
+struct Shard {
+    SymbolId symbol = 0;
+    OrderBook book;
+    TradeStore trades;
+    StopIndex stops;                                   // Untriggered stop and stop-limit orders
+    Price lastTradePrice;                              // Reference for stop triggers (0 before the first trade)
+    bool auctionOpen = false;                          // Collect orders instead of matching
+    std::vector<std::shared_ptr<Order>> auctionMarketOrders;  // Unpriced orders awaiting the uncross
 };
 
 // Exchange class
 class Exchange {
+public:
+    // Event reporting: text log by default, TRADING_BINARY_JOURNAL for a binary
+    // journal, TRADING_SILENT to compile reporting out entirely
+#if defined(TRADING_SILENT)
+    using Reporter = NullReporter;
+#elif defined(TRADING_BINARY_JOURNAL)
+    using Reporter = BinaryJournal;
+#else
+    using Reporter = TextReporter;
+#endif
+
 private:
-    OrderBook orderBook;
-    std::vector<Trade> trades;
-    std::unordered_map<std::string, std::shared_ptr<Trader>> traders;
+    std::vector<std::unique_ptr<Shard>> shards;  // Indexed by SymbolId
+    OrderPool* orderPool;  // Owned; released in the destructor
+    std::unordered_map<TraderId, std::shared_ptr<Trader>> traders;
+    mutable Reporter reporter;  // Flushed from const display methods
+    ExchangeStats stats;
+    SelfTradePrevention selfTradePrevention = SelfTradePrevention::NONE;
+
+    // Shard for a symbol (nullptr if the symbol is not listed)
+    Shard* findShard(SymbolId symbol);
+
+    // Match order, streaming each trade to the store, the reporter and sink
+    // (if any), and counting trades and volume into tally
+    std::size_t matchOrder(Shard& shard, Order& order, TradeSink* sink, ExchangeStats& tally);
+
+    // Stamp, match and rest an order in its symbol's shard, counting it into tally,
+    // then release any stops its trades reach. Touches only that shard, so
+    // different shards may run on different threads.
+    std::size_t execute(std::shared_ptr<Order> order, TradeSink* sink, ExchangeStats& tally);
+
+    // Release the stops the shard's last trade price reaches and place them
+    std::size_t releaseStops(Shard& shard, TradeSink* sink, ExchangeStats& tally);
+
+    // Match (or collect) one order that is not held as a stop
+    std::size_t place(Shard& shard, std::shared_ptr<Order> order, TradeSink* sink, ExchangeStats& tally);
+
+    // Add an order to an open auction without matching it
+    void collectOrder(Shard& shard, std::shared_ptr<Order> order, ExchangeStats& tally);
+
+    // Uncross a shard's auction at one clearing price
+    std::size_t uncross(Shard& shard, TradeSink* sink);
 
-    // Match order
-    std::vector<Trade> matchOrder(std::shared_ptr<Order> order);
+    // Modify a resting order; a requeued order's trades go to sink (if any)
+    bool modifyOrder(SymbolId symbol, OrderId orderId, Price newPrice, Qty newQuantity, TradeSink* sink);
     
 public:
+    // List symbols 0 .. symbolCount - 1 (symbol 0 is the default instrument)
+    explicit Exchange(SymbolId symbolCount = 1);
+    ~Exchange();
+    Exchange(const Exchange&) = delete;
+    Exchange& operator=(const Exchange&) = delete;
+
+    // Create an order whose storage is recycled through the exchange's pool
+    template <typename T, typename... Args>
+    std::shared_ptr<T> createOrder(Args&&... args) {
+        return std::allocate_shared<T>(PoolAllocator<T>(orderPool), std::forward<Args>(args)...);
+    }
+    
     
     // Register a new trader
     std::shared_ptr<Trader> registerTrader();
@@ -41,18 +112,63 @@ public:
     
     // Submit order
     std::vector<Trade> submitOrder(std::shared_ptr<Order> order);
+
+    // Submit order, streaming its trades to sink; returns the number of trades.
+    // Allocates nothing beyond what the sink itself does.
+    std::size_t submitOrder(std::shared_ptr<Order> order, TradeSink& sink);
+
+    // Submit a batch in sequence with the same matching semantics as
+    // submitOrder, reserving trade storage and updating stats once per batch
+    std::vector<Trade> submitOrders(std::span<const std::shared_ptr<Order>> orders);
+    std::size_t submitOrders(std::span<const std::shared_ptr<Order>> orders, TradeSink& sink);
+
+    // Submit a batch with each symbol's orders matched, in sequence, by one
+    // thread. Shards are spread over up to maxThreads threads (0: one per
+    // hardware thread); returns the number of trades.
+    std::size_t submitOrdersParallel(std::span<const std::shared_ptr<Order>> orders, std::size_t maxThreads = 0);
     
-    // Cancel order
-    bool cancelOrder(const std::string& orderId);
+    // Call auction. While a symbol's auction is open its orders are collected
+    // (limit orders rest, possibly crossed) instead of matched. Uncrossing
+    // executes every crossing order at a single clearing price and leaves
+    // the auction open for the next interval; closing uncrosses once more and
+    // returns the symbol to continuous matching. Unfilled market orders are
+    // cancelled at each uncross; IOC and FOK orders are rejected while open.
+    void openAuction(SymbolId symbol = 0);
+    std::vector<Trade> uncrossAuction(SymbolId symbol = 0);
+    std::size_t uncrossAuction(SymbolId symbol, TradeSink& sink);
+    std::vector<Trade> closeAuction(SymbolId symbol = 0);
+    bool isAuctionOpen(SymbolId symbol = 0) const;
+
+    // Cancel order, resting or held as a stop (default symbol unless one is given)
+    bool cancelOrder(OrderId orderId);
+    bool cancelOrder(SymbolId symbol, OrderId orderId);
     
-    // Modify order
-    bool modifyOrder(const std::string& orderId, double newPrice, double newQuantity);
+    // Modify order (default symbol unless one is given)
+    bool modifyOrder(OrderId orderId, Price newPrice, Qty newQuantity);
+    bool modifyOrder(SymbolId symbol, OrderId orderId, Price newPrice, Qty newQuantity);
+    bool modifyOrder(SymbolId symbol, OrderId orderId, Price newPrice, Qty newQuantity, TradeSink& sink);
+
+    // Self-trade prevention applied by the matcher (NONE by default)
+    void setSelfTradePrevention(SelfTradePrevention mode);
+    SelfTradePrevention getSelfTradePrevention() const;
+
+    // Number of listed symbols
+    SymbolId getSymbolCount() const;
     
-    // Get order book
-    const OrderBook& getOrderBook() const;
+    // Get a symbol's order book (throws std::out_of_range for unlisted symbols)
+    const OrderBook& getOrderBook(SymbolId symbol = 0) const;
     
-    // Get trades
-    const std::vector<Trade>& getTrades() const;
+    // Get a symbol's trades (throws std::out_of_range for unlisted symbols)
+    const TradeStore& getTrades(SymbolId symbol = 0) const;
+
+    // Get order pool
+    const OrderPool& getOrderPool() const;
+
+    // Get activity totals
+    const ExchangeStats& getStats() const;
+
+    // Wait until every reported event has been written
+    void flushLog() const;
 };
 
 // Helper function to get current timestamp 
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ostream>
+
+// Price ticks per currency unit (tick size 0.01 by default)
+#ifndef TRADING_PRICE_SCALE
+#define TRADING_PRICE_SCALE 100
+#endif
+
+// Quantity lots per unit (lot size 0.001 by default)
+#ifndef TRADING_QTY_SCALE
+#define TRADING_QTY_SCALE 1000
+#endif
+
+namespace trading {
+
+// Fixed-point decimal stored as an integer number of 1/Scale steps.
+// Tag keeps otherwise identical types (Price, Qty) from mixing.
+template <typename Tag, std::int64_t Scale>
+class FixedPoint {
+private:
+    std::int64_t value;
+
+public:
+    static constexpr std::int64_t scale = Scale;
+
+    constexpr FixedPoint(): value(0) {
+    }
+
+    // Round a decimal to the nearest step
+    FixedPoint(double decimal): value(std::llround(decimal * static_cast<double>(Scale))) {
+    }
+
+    // Build from a raw step count
+    static constexpr FixedPoint fromRaw(std::int64_t raw) {
+        FixedPoint result;
+        result.value = raw;
+        return result;
+    }
+
+    // Largest and smallest representable values
+    static constexpr FixedPoint max() {
+        return fromRaw(std::numeric_limits<std::int64_t>::max());
+    }
+    static constexpr FixedPoint min() {
+        return fromRaw(std::numeric_limits<std::int64_t>::min());
+    }
+
+    // Size of one step (tick or lot)
+    static constexpr double resolution() {
+        return 1.0 / static_cast<double>(Scale);
+    }
+
+    // Raw step count
+    constexpr std::int64_t raw() const {
+        return value;
+    }
+
+    // Convert back to a decimal for output and analytics
+    constexpr double toDouble() const {
+        return static_cast<double>(value) / static_cast<double>(Scale);
+    }
+    explicit constexpr operator double() const {
+        return toDouble();
+    }
+
+    // Comparison
+    friend constexpr bool operator==(const FixedPoint& lhs, const FixedPoint& rhs) = default;
+    friend constexpr auto operator<=>(const FixedPoint& lhs, const FixedPoint& rhs) = default;
+
+    // Arithmetic
+    friend constexpr FixedPoint operator+(FixedPoint lhs, FixedPoint rhs) {
+        return fromRaw(lhs.value + rhs.value);
+    }
+    friend constexpr FixedPoint operator-(FixedPoint lhs, FixedPoint rhs) {
+        return fromRaw(lhs.value - rhs.value);
+    }
+    constexpr FixedPoint& operator+=(FixedPoint other) {
+        value += other.value;
+        return *this;
+    }
+    constexpr FixedPoint& operator-=(FixedPoint other) {
+        value -= other.value;
+        return *this;
+    }
+
+    // Display as a decimal using the stream's formatting
+    friend std::ostream& operator<<(std::ostream& os, const FixedPoint& fixed) {
+        return os << fixed.toDouble();
+    }
+};
+
+struct PriceTag {};
+struct QtyTag {};
+
+// Limit and trade prices, in ticks
+using Price = FixedPoint<PriceTag, TRADING_PRICE_SCALE>;
+
+// Order and trade quantities, in lots
+using Qty = FixedPoint<QtyTag, TRADING_QTY_SCALE>;
+
+}
+
+// Hash on the raw step count so prices can key unordered containers exactly
+template <typename Tag, std::int64_t Scale>
+struct std::hash<trading::FixedPoint<Tag, Scale>> {
+    std::size_t operator()(const trading::FixedPoint<Tag, Scale>& fixed) const noexcept {
+        return std::hash<std::int64_t>{}(fixed.raw());
+    }
+};
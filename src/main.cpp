@@ -93,6 +93,7 @@ int main() {
 
         // Create an exchange and register three traders
         trading::Exchange exchange;
+        exchange.setSelfTradePrevention(trading::SelfTradePrevention::CANCEL_OLDEST);  // A fresh quote replaces a stale one
         auto marketMaker    = exchange.registerTrader();
         auto informedTrader = exchange.registerTrader();
         auto noiseTrader    = exchange.registerTrader();
@@ -105,8 +106,8 @@ int main() {
         auto mmAskOrder = marketMaker->createLimitOrder(currentAsk, 1e6, false);
         exchange.submitOrder(mmBidOrder);
         exchange.submitOrder(mmAskOrder);
-        std::string mmBidId = mmBidOrder->getId();
-        std::string mmAskId = mmAskOrder->getId();
+        trading::OrderId mmBidId = mmBidOrder->getId();
+        trading::OrderId mmAskId = mmAskOrder->getId();
 
         // Output file for logging
         std::ofstream outFile("masterpiece_simulation.csv");
@@ -118,6 +119,10 @@ int main() {
         outFile << "time,arrival,trader_type,order_type,is_buy,quantity,exec_price_avg,num_trades,"
                 << "best_bid,best_ask,spread,belief_p,true_value,fees\n";
 
+        // Trades of the current arrival, collected into one reused buffer
+        std::vector<trading::Trade> tradesExecuted;
+        trading::VectorTradeSink tradeSink(tradesExecuted);
+
         // Main time-stepping loop
         for (int step = 0; step < numSteps; ++step) {
             double currentTime = step * dt;
@@ -156,7 +161,7 @@ int main() {
             double arrivalProb = 1.0 - std::exp(-lambda * dt);
             bool arrivalOccurs = (uniDist(rng) < arrivalProb);
 
-            std::vector<trading::Trade> tradesExecuted;
+            tradesExecuted.clear();
             std::string traderTypeStr = "none";
             std::string orderTypeStr = "none";
             bool isBuy = false;
@@ -190,11 +195,11 @@ int main() {
                                 ? (trueValue - informedOrderAggression)
                                 : (trueValue + informedOrderAggression);
                             auto lo = informedTrader->createLimitOrder(limitPrice, quantity, isBuy);
-                            tradesExecuted = exchange.submitOrder(lo);
+                            exchange.submitOrder(lo, tradeSink);
                         } else {
                             orderTypeStr = "MARKET";
                             auto mo = informedTrader->createMarketOrder(quantity, isBuy);
-                            tradesExecuted = exchange.submitOrder(mo);
+                            exchange.submitOrder(mo, tradeSink);
                         }
                     }
                 } else {
@@ -206,11 +211,11 @@ int main() {
                     if (placeLimit) {
                         orderTypeStr = "LIMIT";
                         auto lo = noiseTrader->createLimitOrder(isBuy ? currentBid : currentAsk, quantity, isBuy);
-                        tradesExecuted = exchange.submitOrder(lo);
+                        exchange.submitOrder(lo, tradeSink);
                     } else {
                         orderTypeStr = "MARKET";
                         auto mo = noiseTrader->createMarketOrder(quantity, isBuy);
-                        tradesExecuted = exchange.submitOrder(mo);
+                        exchange.submitOrder(mo, tradeSink);
                     }
                 }
 
@@ -219,9 +224,11 @@ int main() {
                     double sumPrices = 0.0;
                     double totalQty = 0.0;
                     for (const auto& tr : tradesExecuted) {
-                        sumPrices += tr.price * tr.quantity;
-                        totalQty += tr.quantity;
-                        feesCharged += tr.price * tr.quantity * transactionFeeRate;
+                        double tradePrice = tr.price.toDouble();
+                        double tradeQty = tr.quantity.toDouble();
+                        sumPrices += tradePrice * tradeQty;
+                        totalQty += tradeQty;
+                        feesCharged += tradePrice * tradeQty * transactionFeeRate;
                     }
                     numTrades = static_cast<int>(tradesExecuted.size());
                     if (totalQty > 0.0) {
@@ -251,16 +258,15 @@ int main() {
                 beliefP = beliefUpperBound;
             }
 
-            // Query the actual best quotes from the order book
+            // Query the actual best quotes from the cached top of book
             double bestBid = 0.0;
             double bestAsk = 0.0;
-            auto bestBidOrder = exchange.getOrderBook().getHighestBid();
-            auto bestAskOrder = exchange.getOrderBook().getLowestAsk();
-            if (bestBidOrder) {
-                bestBid = bestBidOrder->getPrice();
+            trading::TopOfBook top = exchange.getOrderBook().getTopOfBook();
+            if (top.bid.orderCount > 0) {
+                bestBid = top.bid.price.toDouble();
             }
-            if (bestAskOrder) {
-                bestAsk = bestAskOrder->getPrice();
+            if (top.ask.orderCount > 0) {
+                bestAsk = top.ask.price.toDouble();
             }
             double spread = 0.0;
             if (bestAsk > 0.0 && bestBid > 0.0) {
@@ -0,0 +1,187 @@
+#include "matching_engine.hpp"
+#include <chrono>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace trading {
+
+// Pin a thread to one CPU (false if unsupported or refused)
+static bool pinToCpu(std::thread& thread, int cpu) {
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+    (void)thread;
+    (void)cpu;
+    return false;
+#endif
+}
+
+// Constructor: start (and optionally pin) the matching thread
+MatchingEngine::MatchingEngine(Exchange& exchange, std::size_t capacity, int cpu):
+    exchange(exchange), commands(capacity), results(capacity), trades(capacity) {
+    worker = std::thread(&MatchingEngine::run, this);
+    if (cpu >= 0) {
+        pinned = pinToCpu(worker, cpu);
+    }
+}
+
+// Destructor: apply whatever is still queued, then stop the matching thread
+MatchingEngine::~MatchingEngine() {
+    stopping.store(true, std::memory_order_release);
+    worker.join();
+}
+
+// Queue a command, waiting while the ring is full
+std::uint64_t MatchingEngine::post(Command command) {
+    command.sequence = nextSequence.fetch_add(1, std::memory_order_relaxed);
+    while (!commands.tryPush(command)) {
+        stalls.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::yield();
+    }
+    posted.fetch_add(1, std::memory_order_release);
+    return command.sequence;
+}
+
+// Post a new order
+std::uint64_t MatchingEngine::submit(std::shared_ptr<Order> order) {
+    Command command;
+    command.type = CommandType::NEW;
+    command.order = std::move(order);
+    return post(std::move(command));
+}
+
+// Post a cancel
+std::uint64_t MatchingEngine::cancel(SymbolId symbol, OrderId orderId) {
+    Command command;
+    command.type = CommandType::CANCEL;
+    command.symbol = symbol;
+    command.orderId = orderId;
+    return post(std::move(command));
+}
+
+// Post a modify
+std::uint64_t MatchingEngine::modify(SymbolId symbol, OrderId orderId, Price newPrice, Qty newQuantity) {
+    Command command;
+    command.type = CommandType::MODIFY;
+    command.symbol = symbol;
+    command.orderId = orderId;
+    command.price = newPrice;
+    command.quantity = newQuantity;
+    return post(std::move(command));
+}
+
+// Take the oldest result
+bool MatchingEngine::pollResult(CommandResult& out) {
+    return results.tryPop(out);
+}
+
+// Take the oldest trade
+bool MatchingEngine::pollTrade(Trade& out) {
+    return trades.tryPop(out);
+}
+
+// Block until every command posted so far has been processed
+void MatchingEngine::waitIdle() const {
+    std::uint64_t target = posted.load(std::memory_order_acquire);
+    while (processed.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
+    }
+}
+
+// Whether the matching thread was pinned
+bool MatchingEngine::isPinned() const {
+    return pinned;
+}
+
+// Number of times a ring was found full
+std::uint64_t MatchingEngine::getStalls() const {
+    return stalls.load(std::memory_order_relaxed);
+}
+
+// Results and trades discarded on shutdown
+std::uint64_t MatchingEngine::getDropped() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+// Push to an outbound ring, waiting while it is full (gives up on shutdown)
+template <typename T>
+void MatchingEngine::publish(BoundedQueue<T>& queue, const T& value) {
+    while (!queue.tryPush(value)) {
+        if (stopping.load(std::memory_order_acquire)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        stalls.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::yield();
+    }
+}
+
+// Matching loop: busy-polls so a command is picked up without a wake-up delay
+void MatchingEngine::run() {
+    Command command;
+    std::uint64_t count = 0;
+    for (;;) {
+        bool stop = stopping.load(std::memory_order_acquire);
+        bool appliedAny = false;
+        while (commands.tryPop(command)) {
+            CommandResult result = apply(command);
+            command.order.reset();
+            publish(results, result);
+            processed.store(++count, std::memory_order_release);
+            appliedAny = true;
+        }
+        if (stop) {
+            return;
+        }
+        if (!appliedAny) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// Apply one command to the exchange
+CommandResult MatchingEngine::apply(Command& command) {
+    CommandResult result;
+    result.sequence = command.sequence;
+    result.type = command.type;
+    switch (command.type) {
+        case CommandType::NEW: {
+            if (!command.order) {
+                break;
+            }
+            result.orderId = command.order->getId();
+            result.accepted = command.order->getSymbol() < exchange.getSymbolCount();
+            CallbackTradeSink sink([this](const Trade& trade) {
+                publish(trades, trade);
+            });
+            result.trades = static_cast<std::uint32_t>(exchange.submitOrder(std::move(command.order), sink));
+            break;
+        }
+        case CommandType::CANCEL:
+            result.orderId = command.orderId;
+            result.accepted = exchange.cancelOrder(command.symbol, command.orderId);
+            break;
+        case CommandType::MODIFY: {
+            result.orderId = command.orderId;
+            CallbackTradeSink sink([&](const Trade& trade) {
+                publish(trades, trade);
+                ++result.trades;
+            });
+            result.accepted = exchange.modifyOrder(command.symbol, command.orderId, command.price, command.quantity, sink);
+            break;
+        }
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "bounded_queue.hpp"
+#include "exchange.hpp"
+#include "order.hpp"
+#include "trade.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace trading {
+
+// Kind of request posted to the matching thread
+enum class CommandType : std::uint8_t {
+    NEW,      // Submit order
+    CANCEL,   // Cancel orderId in symbol
+    MODIFY    // Modify orderId in symbol to price/quantity
+};
+
+// One request for the matching thread
+struct Command {
+    CommandType type = CommandType::NEW;
+    std::uint64_t sequence = 0;     // Assigned by the engine when posted
+    std::shared_ptr<Order> order;   // NEW only
+    SymbolId symbol = 0;            // CANCEL and MODIFY
+    OrderId orderId = 0;            // CANCEL and MODIFY
+    Price price;                    // MODIFY
+    Qty quantity;                   // MODIFY
+};
+
+// Outcome of one command, published in the order commands were processed
+struct CommandResult {
+    std::uint64_t sequence = 0;     // Matches the value returned when the command was posted
+    CommandType type = CommandType::NEW;
+    OrderId orderId = 0;
+    bool accepted = false;          // NEW: symbol listed; CANCEL/MODIFY: order found and changed
+    std::uint32_t trades = 0;       // Trades the command caused
+};
+
+// Asynchronous front end for an Exchange.
+// Any number of threads post commands into a lock-free ring; a single matching
+// thread drains it, applies each command to the exchange and publishes a
+// CommandResult, plus every trade, on outbound rings. While the engine runs it
+// is the exchange's only user: register traders before constructing it, and
+// read the exchange only after waitIdle() or once the engine is destroyed.
+// A full inbound ring makes the poster wait; a full outbound ring makes the
+// matching thread wait, so consumers should keep polling.
+class MatchingEngine {
+public:
+    // Start the matching thread, pinned to cpu when cpu >= 0 (Linux only)
+    explicit MatchingEngine(Exchange& exchange, std::size_t capacity = 8192, int cpu = -1);
+
+    // Process every command already posted, then stop the matching thread
+    ~MatchingEngine();
+
+    MatchingEngine(const MatchingEngine&) = delete;
+    MatchingEngine& operator=(const MatchingEngine&) = delete;
+
+    // Post commands; each returns the sequence number its result will carry
+    std::uint64_t submit(std::shared_ptr<Order> order);
+    std::uint64_t cancel(SymbolId symbol, OrderId orderId);
+    std::uint64_t modify(SymbolId symbol, OrderId orderId, Price newPrice, Qty newQuantity);
+
+    // Take the oldest result or trade (false if none is waiting)
+    bool pollResult(CommandResult& out);
+    bool pollTrade(Trade& out);
+
+    // Block until every command posted so far has been processed
+    void waitIdle() const;
+
+    // Whether the matching thread was pinned to the requested CPU
+    bool isPinned() const;
+
+    // Number of times a poster or the matching thread found a ring full
+    std::uint64_t getStalls() const;
+
+    // Results and trades discarded because nobody drained them before shutdown
+    std::uint64_t getDropped() const;
+
+private:
+    Exchange& exchange;
+    BoundedQueue<Command> commands;
+    BoundedQueue<CommandResult> results;
+    BoundedQueue<Trade> trades;
+    alignas(64) std::atomic<std::uint64_t> nextSequence{1};
+    alignas(64) std::atomic<std::uint64_t> posted{0};     // Commands queued
+    alignas(64) std::atomic<std::uint64_t> processed{0};  // Commands applied and published
+    std::atomic<std::uint64_t> stalls{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<bool> stopping{false};
+    bool pinned = false;
+    std::thread worker;
+
+    // Queue a command, waiting while the ring is full
+    std::uint64_t post(Command command);
+
+    // Matching loop: drain commands, apply, publish, spin
+    void run();
+
+    // Apply one command to the exchange
+    CommandResult apply(Command& command);
+
+    // Push to an outbound ring, waiting while it is full (gives up on shutdown)
+    template <typename T>
+    void publish(BoundedQueue<T>& queue, const T& value);
+};
+
+}
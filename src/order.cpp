@@ -1,49 +1,63 @@
 #include "order.hpp"
+#include <algorithm>
+#include <atomic>
 #include <random>
 #include <sstream>
 
 namespace trading {
 
-// Order parent class implementation
+// Format IDs for display
+std::string formatOrderId(OrderId id) {
+    return "ORD-" + std::to_string(id);
+}
+std::string formatTraderId(TraderId id) {
+    return "TRD-" + std::to_string(id);
+}
 
-// Forward definition
-std::string generateOrderId();
+// Order parent class implementation
 
 // Order constructor
-Order::Order(std::string traderId, double quantity, bool isBuy): 
-    traderId(std::move(traderId)), quantity(quantity), isBuy(isBuy) {
-        if (quantity <= 0) {
+Order::Order(TraderId traderId, Qty quantity, bool isBuy, SymbolId symbol): 
+    traderId(traderId), quantity(quantity), isBuy(isBuy), symbol(symbol) {
+        if (quantity <= Qty()) {
             throw std::invalid_argument("Order quantity must be greater than zero.");
         }
         // Generate sequential order ID
-        static unsigned int nextOrderId = 1;
-        id = "ORD-" + std::to_string(nextOrderId++);
+        static std::atomic<OrderId> nextOrderId{1};
+        id = nextOrderId.fetch_add(1, std::memory_order_relaxed);
 }
 
 // Getters
-const std::string& Order::getId() const {
+OrderId Order::getId() const {
     return id;
 }
-const std::string& Order::getTraderId() const {
+TraderId Order::getTraderId() const {
     return traderId;
 }
-double Order::getQuantity() const {
+Qty Order::getQuantity() const {
     return quantity;
 }
 bool Order::isBuyOrder() const {
     return isBuy;
 }
+SymbolId Order::getSymbol() const {
+    return symbol;
+}
+
+Timestamp Order::getTimestamp() const {
+    return timestamp;
+}
 
 // LimitOrder implementation
 
 // LimitOrder constructor
-LimitOrder::LimitOrder(std::string traderId, double price, double quantity, bool isBuy): 
-    Order(std::move(traderId), quantity, isBuy), price(price) {
-        if (quantity <= 0) {
+LimitOrder::LimitOrder(TraderId traderId, Price price, Qty quantity, bool isBuy, SymbolId symbol): 
+    Order(traderId, quantity, isBuy, symbol), price(price) {
+        if (quantity <= Qty()) {
             throw std::invalid_argument("Order quantity must be greater than zero.");
         }
         
-        if (price <= 0) {
+        if (price <= Price()) {
             throw std::invalid_argument("Limit price must be greater than zero.");
         }
 }
@@ -54,35 +68,184 @@ OrderType LimitOrder::getType() const{
 }
 
 // Get order price
-double LimitOrder::getPrice() const {
+Price LimitOrder::getPrice() const {
     return price;
 }
 
 // Display Limit Order
 std::string LimitOrder::toString() const {
     std::stringstream ss;
-    ss << "Order " << id << " (" << (isBuy ? "BUY" : "SELL") << "): "
-       << "Trader " << traderId << " | "
+    ss << "Order " << formatOrderId(id) << " (" << (isBuy ? "BUY" : "SELL") << "): "
+       << "Trader " << formatTraderId(traderId) << " | "
        << quantity << " units @ $" << price;
     return ss.str();
 }
 
 // Modify price
-void LimitOrder::setPrice(double newPrice) {
+void LimitOrder::setPrice(Price newPrice) {
     price = newPrice;
 }
 
 // Modify quantity
-void Order::setQuantity(double newQuantity) {
+void Order::setQuantity(Qty newQuantity) {
     quantity = newQuantity;
 }
 
+// Stamp the time the exchange accepted the order
+void Order::setTimestamp(Timestamp newTimestamp) {
+    timestamp = newTimestamp;
+}
+
+// IocOrder implementation
+
+IocOrder::IocOrder(TraderId traderId, Price price, Qty quantity, bool isBuy, SymbolId symbol):
+    LimitOrder(traderId, price, quantity, isBuy, symbol) {
+}
+
+OrderType IocOrder::getType() const {
+    return OrderType::IOC;
+}
+
+std::string IocOrder::toString() const {
+    return LimitOrder::toString() + " IOC";
+}
+
+// FokOrder implementation
+
+FokOrder::FokOrder(TraderId traderId, Price price, Qty quantity, bool isBuy, SymbolId symbol):
+    LimitOrder(traderId, price, quantity, isBuy, symbol) {
+}
+
+OrderType FokOrder::getType() const {
+    return OrderType::FOK;
+}
+
+std::string FokOrder::toString() const {
+    return LimitOrder::toString() + " FOK";
+}
+
+// IcebergOrder implementation
+
+IcebergOrder::IcebergOrder(TraderId traderId, Price price, Qty quantity, Qty displaySize, bool isBuy, SymbolId symbol):
+    LimitOrder(traderId, price, quantity, isBuy, symbol), displaySize(displaySize) {
+        if (displaySize <= Qty()) {
+            throw std::invalid_argument("Display size must be greater than zero.");
+        }
+}
+
+Qty IcebergOrder::getDisplaySize() const {
+    return displaySize;
+}
+
+Qty IcebergOrder::getHiddenQuantity() const {
+    return hidden;
+}
+
+Qty IcebergOrder::getTotalQuantity() const {
+    return quantity + hidden;
+}
+
+// Resize the reserve to match a new total, cutting the visible slice only
+// once the reserve is gone
+void IcebergOrder::setTotalQuantity(Qty total) {
+    if (total >= quantity) {
+        hidden = total - quantity;
+    } else {
+        quantity = total;
+        hidden = Qty();
+    }
+}
+
+// Keep displaySize visible and move the rest into the reserve
+void IcebergOrder::concealReserve() {
+    if (quantity > displaySize) {
+        hidden += quantity - displaySize;
+        quantity = displaySize;
+    }
+}
+
+// Show the next slice from the reserve
+Qty IcebergOrder::replenish() {
+    Qty slice = std::min(displaySize, hidden);
+    hidden -= slice;
+    quantity += slice;
+    return slice;
+}
+
+std::string IcebergOrder::toString() const {
+    std::stringstream ss;
+    ss << LimitOrder::toString() << " (iceberg, " << hidden << " hidden)";
+    return ss.str();
+}
+
+// StopCondition implementation
+
+StopCondition::StopCondition(Price stopPrice): stopPrice(stopPrice) {
+    if (stopPrice <= Price()) {
+        throw std::invalid_argument("Stop price must be greater than zero.");
+    }
+}
+
+Price StopCondition::getStopPrice() const {
+    return stopPrice;
+}
+
+bool StopCondition::isTriggered() const {
+    return triggered;
+}
+
+bool StopCondition::isReachedBy(Price lastPrice, bool isBuy) const {
+    return isBuy ? lastPrice >= stopPrice : lastPrice <= stopPrice;
+}
+
+void StopCondition::trigger() {
+    triggered = true;
+}
+
+// StopOrder implementation
+
+StopOrder::StopOrder(TraderId traderId, Price stopPrice, Qty quantity, bool isBuy, SymbolId symbol):
+    Order(traderId, quantity, isBuy, symbol), StopCondition(stopPrice) {
+}
+
+OrderType StopOrder::getType() const {
+    return triggered ? OrderType::MARKET : OrderType::STOP;
+}
+
+Price StopOrder::getPrice() const {
+    return Price();
+}
+
+std::string StopOrder::toString() const {
+    std::stringstream ss;
+    ss << "Order " << formatOrderId(id) << " (" << (isBuy ? "BUY" : "SELL") << "): "
+       << "Trader " << formatTraderId(traderId) << " | "
+       << quantity << " units @ MARKET, stop $" << stopPrice;
+    return ss.str();
+}
+
+// StopLimitOrder implementation
+
+StopLimitOrder::StopLimitOrder(TraderId traderId, Price stopPrice, Price price, Qty quantity, bool isBuy, SymbolId symbol):
+    LimitOrder(traderId, price, quantity, isBuy, symbol), StopCondition(stopPrice) {
+}
+
+OrderType StopLimitOrder::getType() const {
+    return triggered ? OrderType::LIMIT : OrderType::STOP_LIMIT;
+}
+
+std::string StopLimitOrder::toString() const {
+    std::stringstream ss;
+    ss << LimitOrder::toString() << ", stop $" << stopPrice;
+    return ss.str();
+}
+
 // MarketOrder implementation
 
 // MarketOrder constructor
-MarketOrder::MarketOrder(std::string traderId, double quantity, bool isBuy): 
-    Order(std::move(traderId), quantity, isBuy) {
-        if (quantity <= 0) {
+MarketOrder::MarketOrder(TraderId traderId, Qty quantity, bool isBuy, SymbolId symbol): 
+    Order(traderId, quantity, isBuy, symbol) {
+        if (quantity <= Qty()) {
             throw std::invalid_argument("Order quantity must be greater than zero.");
         }
 }
@@ -93,15 +256,15 @@ OrderType MarketOrder::getType() const {
 }
 
 // Get order price
-double MarketOrder::getPrice() const {
-    return 0.0;
+Price MarketOrder::getPrice() const {
+    return Price();
 }
 
 // Display Market Order
 std::string MarketOrder::toString() const{
     std::stringstream ss;
-    ss << "Order " << id << " (" << (isBuy ? "BUY" : "SELL") << "): "
-       << "Trader " << traderId << " | "
+    ss << "Order " << formatOrderId(id) << " (" << (isBuy ? "BUY" : "SELL") << "): "
+       << "Trader " << formatTraderId(traderId) << " | "
        << quantity << " units @ MARKET";
     return ss.str();
 }
@@ -1,26 +1,46 @@
 #pragma once
 
+#include "clock.hpp"
+#include "fixed_point.hpp"
 #include <string>
 #include <memory>
+#include <cstdint>
 
 namespace trading {
 
+// Numeric identifiers (formatted as "ORD-n"/"TRD-n" only for display)
+using OrderId = std::uint64_t;
+using TraderId = std::uint64_t;
+
+// Dense instrument index (0 is the default instrument)
+using SymbolId = std::uint32_t;
+
+// Format IDs for display
+std::string formatOrderId(OrderId id);
+std::string formatTraderId(TraderId id);
+
 // Enum class for Order types
 enum class OrderType {
     LIMIT,
-    MARKET
+    MARKET,
+    IOC,        // Limit price; whatever does not fill at once is cancelled
+    FOK,        // Limit price; fills in full at once or not at all
+    STOP,       // Becomes a market order once a trade reaches the stop price
+    STOP_LIMIT  // Becomes a limit order once a trade reaches the stop price
 };
 
 // Parent Order class
 class Order {
 protected:
-    std::string id;
-    std::string traderId;
-    double quantity;
+    OrderId id;
+    TraderId traderId;
+    Qty quantity;
     bool isBuy;
+    SymbolId symbol;
+    Timestamp timestamp = 0;  // Monotonic time the exchange accepted the order (0 before submission)
     
     // Constructor
-    Order(std::string traderId, double quantity, bool isBuy);
+    Order(TraderId traderId, Qty quantity, bool isBuy, SymbolId symbol);
 
 public:
     virtual ~Order() = default;
@@ -31,31 +51,47 @@ public:
     virtual OrderType getType() const = 0;
 
     // Get order price
-    virtual double getPrice() const = 0;
+    virtual Price getPrice() const = 0;
 
     // Display Order
     virtual std::string toString() const = 0;
     
     // Getters
-    const std::string& getId() const;
-    const std::string& getTraderId() const;
-    double getQuantity() const;
+    OrderId getId() const;
+    TraderId getTraderId() const;
+    Qty getQuantity() const;
     bool isBuyOrder() const;
+    SymbolId getSymbol() const;
+    Timestamp getTimestamp() const;
     
     // Modify quantity 
-    void setQuantity(double newQuantity);
+    void setQuantity(Qty newQuantity);
+
+    // Stamp the time the exchange accepted the order
+    void setTimestamp(Timestamp newTimestamp);
+
+    // Iceberg hooks, no-ops for ordinary orders. The book conceals the
+    // reserve when the order rests, and asks for the next slice each time
+    // the visible quantity is filled (0 when nothing is left in reserve).
+    virtual void concealReserve() {}
+    virtual Qty replenish() { return Qty(); }
+
+    // Visible plus hidden quantity, and an amend of that full size (an
+    // iceberg's reserve absorbs the change before its visible slice does)
+    virtual Qty getTotalQuantity() const { return quantity; }
+    virtual void setTotalQuantity(Qty total) { quantity = total; }
 };
 
 // Child LimitOrder class
 class LimitOrder : public Order {
 private:
-    double price;
+    Price price;
 
 public:
     // Flag for limit order
     bool isValid;
 
-    LimitOrder(std::string traderId, double price, double quantity, bool isBuy);
+    LimitOrder(TraderId traderId, Price price, Qty quantity, bool isBuy, SymbolId symbol = 0);
     
     // Abstract methods
 
@@ -63,19 +99,101 @@ public:
     OrderType getType() const override;
 
     // Get order price
-    double getPrice() const override;
+    Price getPrice() const override;
 
     // Display Limit Order
     std::string toString() const override;
     
     // Modify price
-    void setPrice(double newPrice);
+    void setPrice(Price newPrice);
+};
+
+// Immediate-or-cancel: matches like a limit order but never rests
+class IocOrder : public LimitOrder {
+public:
+    IocOrder(TraderId traderId, Price price, Qty quantity, bool isBuy, SymbolId symbol = 0);
+
+    OrderType getType() const override;
+    std::string toString() const override;
+};
+
+// Fill-or-kill: matches in full like a limit order, or is cancelled untouched
+class FokOrder : public LimitOrder {
+public:
+    FokOrder(TraderId traderId, Price price, Qty quantity, bool isBuy, SymbolId symbol = 0);
+
+    OrderType getType() const override;
+    std::string toString() const override;
+};
+
+// Iceberg order: matches its full size on entry, then rests showing at most
+// displaySize. Each time the visible slice fills, the next slice is drawn
+// from the hidden reserve and joins the back of its price level.
+class IcebergOrder : public LimitOrder {
+private:
+    Qty displaySize;
+    Qty hidden;
+
+public:
+    IcebergOrder(TraderId traderId, Price price, Qty quantity, Qty displaySize, bool isBuy, SymbolId symbol = 0);
+
+    Qty getDisplaySize() const;
+    Qty getHiddenQuantity() const;
+
+    void concealReserve() override;
+    Qty replenish() override;
+    Qty getTotalQuantity() const override;
+    void setTotalQuantity(Qty total) override;
+    std::string toString() const override;
+};
+
+// Trigger state shared by stop and stop-limit orders. A buy stop triggers
+// on a trade at or above the stop price, a sell stop at or below it.
+class StopCondition {
+protected:
+    Price stopPrice;
+    bool triggered = false;
+
+    explicit StopCondition(Price stopPrice);
+
+public:
+    virtual ~StopCondition() = default;
+
+    Price getStopPrice() const;
+    bool isTriggered() const;
+
+    // Whether a trade at lastPrice reaches the stop for an order on this side
+    bool isReachedBy(Price lastPrice, bool isBuy) const;
+
+    // Arm the order to behave as its market/limit form from now on
+    void trigger();
+};
+
+// Stop order: held aside until triggered, then matched as a market order
+class StopOrder : public Order, public StopCondition {
+public:
+    StopOrder(TraderId traderId, Price stopPrice, Qty quantity, bool isBuy, SymbolId symbol = 0);
+
+    // STOP until triggered, MARKET after
+    OrderType getType() const override;
+    Price getPrice() const override;
+    std::string toString() const override;
+};
+
+// Stop-limit order: held aside until triggered, then matched as a limit order
+class StopLimitOrder : public LimitOrder, public StopCondition {
+public:
+    StopLimitOrder(TraderId traderId, Price stopPrice, Price price, Qty quantity, bool isBuy, SymbolId symbol = 0);
+
+    // STOP_LIMIT until triggered, LIMIT after
+    OrderType getType() const override;
+    std::string toString() const override;
 };
 
 // Child MarketOrder class
 class MarketOrder : public Order {
 public:
-    MarketOrder(std::string traderId, double quantity, bool isBuy);
+    MarketOrder(TraderId traderId, Qty quantity, bool isBuy, SymbolId symbol = 0);
     
     // Abstract methods
 
@@ -83,7 +201,7 @@ public:
     OrderType getType() const override;
 
     // Get order price
-    double getPrice() const override; 
+    Price getPrice() const override; 
 
     // Display Market Order
     std::string toString() const override;
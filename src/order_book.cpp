@@ -2,222 +2,458 @@
 #include <sstream>
 #include <algorithm>
 #include <iomanip>
-#include <iostream>
+#include <vector>
 
 namespace trading {
 
 // PriceLevel struct implementation
 
 // Constructor
-PriceLevel::PriceLevel(double p): price(p) {
+PriceLevel::PriceLevel(Price p): price(p) {
 }
 
 // Add order
-void PriceLevel::addOrder(std::shared_ptr<Order> order) {
-    try{
-        if (!order){
-            throw std::invalid_argument("Cannot add null order.");
-        }
-        orders.push_back(order);
-    }
-    catch(const std::invalid_argument& exception){
-        std::cerr << "Exception caught: " << exception.what() << "\n";
+OrderQueue::iterator PriceLevel::addOrder(std::shared_ptr<Order> order) {
+    if (!order){
+        return orders.end();
     }
+    totalQuantity += order->getQuantity();
+    hiddenQuantity += order->getTotalQuantity() - order->getQuantity();
+    ++orderCount;
+    return orders.insert(orders.end(), std::move(order));
 }
 
-// Remove order
-bool PriceLevel::removeOrder(const std::string& orderId) {
-    try{
-        for (auto it = orders.begin(); it != orders.end(); ++it) {
-            if ((*it)->getId() == orderId) {
-                orders.erase(it);
-                return true;
-            }
+// Remove order (linear scan; the book uses handles instead)
+bool PriceLevel::removeOrder(OrderId orderId) {
+    for (auto it = orders.begin(); it != orders.end(); ++it) {
+        if ((*it)->getId() == orderId) {
+            removeOrder(it);
+            return true;
         }
-        throw std::runtime_error("Order " + orderId + " not found.");
     }
-    catch (const std::runtime_error& exception){
-        std::cerr << "Exception caught: " << exception.what() << "\n";
+    return false;
+}
+
+// Remove order by its list position (O(1))
+void PriceLevel::removeOrder(OrderQueue::iterator position) {
+    totalQuantity -= (*position)->getQuantity();
+    hiddenQuantity -= (*position)->getTotalQuantity() - (*position)->getQuantity();
+    --orderCount;
+    orders.erase(position);
+}
+
+// Reduce a resting order's quantity in place
+void PriceLevel::reduceOrder(OrderQueue::iterator position, Qty amount) {
+    (*position)->setQuantity((*position)->getQuantity() - amount);
+    totalQuantity -= amount;
+}
+
+// Refill an exhausted iceberg and requeue it; the node and its handle stay valid
+bool PriceLevel::replenishOrder(OrderQueue::iterator position) {
+    Qty slice = (*position)->replenish();
+    if (slice <= Qty()) {
         return false;
     }
+    totalQuantity += slice;
+    hiddenQuantity -= slice;
+    orders.splice(orders.end(), orders, position);
+    return true;
 }
 
-// Find order
-std::shared_ptr<Order> PriceLevel::findOrder(const std::string& orderId) const {
-    try{
-        for (const auto& order : orders) {
-            if (order->getId() == orderId) {
-                return order;
-            }
+// Find order (linear scan; the book uses handles instead)
+std::shared_ptr<Order> PriceLevel::findOrder(OrderId orderId) const {
+    for (const auto& order : orders) {
+        if (order->getId() == orderId) {
+            return order;
         }
-        throw std::runtime_error("Order " + orderId + " not found.");
-    }
-    catch (const std::runtime_error& exception){
-        std::cerr << "Exception caught: " << exception.what() << "\n";
-        return nullptr;
     }
+    return nullptr;
 }
 
 // OrderBook class implementation
 
 // Add order to respective ask/bid tree and to hash map
-void OrderBook::addOrder(std::shared_ptr<Order> order) {
-    try{
-        if (!order){
-            throw std::invalid_argument("Cannot add null order.");
-        }
-        if (order->getType() != OrderType::LIMIT) {
-            throw std::invalid_argument("Order " + order->getId() + "not a Limit order.");
-        }
+BookStatus OrderBook::addOrder(std::shared_ptr<Order> order) {
+    if (!order || order->getType() != OrderType::LIMIT) {
+        ++diagnostics.invalidOrders;
+        return BookStatus::INVALID_ORDER;
+    }
 
-        // Get price
-        double price = order -> getPrice();
-        bool isBuy = order -> isBuyOrder();
+    // Reserve the ID first so a duplicate never reaches a level
+    auto [entry, inserted] = orderMap.try_emplace(order->getId());
+    if (!inserted) {
+        ++diagnostics.invalidOrders;
+        return BookStatus::INVALID_ORDER;
+    }
 
-        // 
-        if (isBuy) {
-            auto it = bids.find(price);
-            if (it == bids.end()) {
-                bids.emplace(price, PriceLevel(price)); 
-            }
-            bids.at(price).addOrder(order); 
-        }
-        else {
-            auto it = asks.find(price);
-            if (it == asks.end()) {
-                asks.emplace(price, PriceLevel(price));
-            }
-            asks.at(price).addOrder(order);
-        }
+    // Icebergs rest showing only their display size
+    order->concealReserve();
 
-        // Store order in hash map for look up by ID
-        orderMap[order->getId()] = std::make_pair(isBuy, price);
+    // Get price
+    Price price = order -> getPrice();
+    bool isBuy = order -> isBuyOrder();
+    Qty quantity = order->getQuantity();
+
+    // Find or create the price level, then append to its queue
+    PriceLevel* level = nullptr;
+    if (isBuy) {
+        level = &bids.getOrCreateLevel(price);
+    }
+    else {
+        level = &asks.getOrCreateLevel(price);
     }
-    catch (std::invalid_argument& exception){
-        std::cerr << "Exception caught: " << exception.what() << "\n";
+    auto position = level->addOrder(std::move(order));
+
+    // Store handle in hash map for O(1) look up by ID
+    entry->second = OrderHandle{isBuy, level, position};
+
+    // Update cached top of book
+    BookTop& side = isBuy ? top.bid : top.ask;
+    bool improves = side.orderCount == 0 || (isBuy ? price > side.price : price < side.price);
+    if (improves) {
+        side = BookTop{price, quantity, 1};
+    } else if (price == side.price) {
+        side.quantity += quantity;
+        ++side.orderCount;
     }
+    return BookStatus::OK;
 }
 
 // Remove order by ID
-bool OrderBook::removeOrder(const std::string& orderId) {
-    try{
-        auto it = orderMap.find(orderId);
-        if (it == orderMap.end()) {
-            throw std::runtime_error("Order " + orderId + " not found.");
-        }
+BookStatus OrderBook::tryRemoveOrder(OrderId orderId) {
+    auto it = orderMap.find(orderId);
+    if (it == orderMap.end()) {
+        ++diagnostics.notFound;
+        return BookStatus::NOT_FOUND;
+    }
+    unlinkOrder(it);
+    return BookStatus::OK;
+}
+
+bool OrderBook::removeOrder(OrderId orderId) {
+    return tryRemoveOrder(orderId) == BookStatus::OK;
+}
+
+// Unlink the node directly through the stored handle
+void OrderBook::unlinkOrder(std::unordered_map<OrderId, OrderHandle>::iterator it) {
+    bool isBuy = it->second.isBuy;
+    PriceLevel* level = it->second.level;
+    Qty quantity = (*it->second.position)->getQuantity();
+    BookTop& side = isBuy ? top.bid : top.ask;
+    bool atTop = level->price == side.price;
 
-        // Get order price level and tree side from hash map
-        double price = it->second.second;
-        bool isBuy = it->second.first;
+    level->removeOrder(it->second.position);
+    orderMap.erase(it);
+
+    // Drop the price level once its queue is empty
+    if (level->orders.empty()) {
         if (isBuy) {
-            auto& tree = bids;
-            auto level = tree.find(price);
-            
-            if (level != tree.end()) {
-                bool removed = level->second.removeOrder(orderId);
-                
-                if (removed) {
-                    if (level->second.orders.empty()) {
-                        tree.erase(level);
-                    }
-                    
-                    orderMap.erase(it);
-                    return true;
-                }
-            }
-        }else {
-            auto& tree = asks;
-            auto level = tree.find(price);
-        
-            if (level != tree.end()) {
-                bool removed = level->second.removeOrder(orderId);
-                
-                if (removed) {
-                    if (level->second.orders.empty()) {
-                        tree.erase(level);
-                    }
-                
-                    orderMap.erase(it);
-                    return true;
-                }
-            }
+            bids.eraseLevel(*level);
+        } else {
+            asks.eraseLevel(*level);
         }
-        return false;
+        if (atTop) {
+            refreshTop(isBuy);
+        }
+    } else if (atTop) {
+        side.quantity -= quantity;
+        --side.orderCount;
     }
-    catch (std::runtime_error& exception){
-        std::cerr << "Exception caught: " << exception.what() << "\n";
-        return false;
+}
+
+// Rebuild the cached top from the new best level's running totals
+void OrderBook::refreshTop(bool isBuy) {
+    BookTop& side = isBuy ? top.bid : top.ask;
+    const PriceLevel* level = isBuy ? bids.bestLevel() : asks.bestLevel();
+    if (!level) {
+        side = BookTop{};
+        return;
     }
+    side = BookTop{level->price, level->totalQuantity, level->orderCount};
 }
 
-// Find order
-std::shared_ptr<Order> OrderBook::findOrder(const std::string& orderId) const {
-    try{
-        auto it = orderMap.find(orderId);
-        if (it == orderMap.end()) {
-            throw std::runtime_error("Order " + orderId + " not found.");
-        }
-         // Get order price level and tree side from hash map
-        double price = it->second.second;
-        bool isBuy = it->second.first;
-        
-        if (isBuy) {
-            auto& tree = bids;
-            auto level = tree.find(price);
-            
-            if (level != tree.end()) {
-                return level->second.findOrder(orderId);
-            }
-        } else {
-            auto& tree = asks;
-            auto level = tree.find(price);
-            
-            if (level != tree.end()) {
-                return level->second.findOrder(orderId);
+// Fill part of a resting order
+bool OrderBook::fillOrder(OrderId orderId, Qty filled) {
+    auto it = orderMap.find(orderId);
+    if (it == orderMap.end()) {
+        ++diagnostics.notFound;
+        return false;
+    }
+
+    const OrderHandle& handle = it->second;
+    Qty current = (*handle.position)->getQuantity();
+    BookTop& side = handle.isBuy ? top.bid : top.ask;
+    bool atTop = handle.level->price == side.price;
+    if (current <= filled) {
+        // An iceberg shows its next slice instead of leaving the book
+        handle.level->reduceOrder(handle.position, current);
+        if (!handle.level->replenishOrder(handle.position)) {
+            if (atTop) {
+                side.quantity -= current;
             }
+            unlinkOrder(it);
+            return true;
+        }
+        if (atTop) {
+            side.quantity += (*handle.position)->getQuantity() - current;
+        }
+        return true;
+    }
+
+    handle.level->reduceOrder(handle.position, filled);
+    if (atTop) {
+        side.quantity -= filled;
+    }
+    return true;
+}
+
+// Shrink a resting order through its handle; the node stays where it is
+BookStatus OrderBook::reduceQuantity(OrderId orderId, Qty newQuantity) {
+    auto it = orderMap.find(orderId);
+    if (it == orderMap.end()) {
+        ++diagnostics.notFound;
+        return BookStatus::NOT_FOUND;
+    }
+
+    const OrderHandle& handle = it->second;
+    Order& order = **handle.position;
+    if (newQuantity <= Qty() || newQuantity >= order.getTotalQuantity()) {
+        ++diagnostics.invalidOrders;
+        return BookStatus::INVALID_ORDER;
+    }
+
+    // An iceberg's reserve goes first; only a cut into the visible slice
+    // changes the level total and top of book
+    Qty current = order.getQuantity();
+    Qty hidden = order.getTotalQuantity() - current;
+    if (newQuantity < current) {
+        Qty amount = current - newQuantity;
+        handle.level->reduceOrder(handle.position, amount);
+        BookTop& side = handle.isBuy ? top.bid : top.ask;
+        if (handle.level->price == side.price) {
+            side.quantity -= amount;
         }
-        return nullptr;
     }
-    catch (std::runtime_error& exception){
-        std::cerr << "Exception caught: " << exception.what() << "\n";
+    order.setTotalQuantity(newQuantity);
+    handle.level->hiddenQuantity -= hidden - (order.getTotalQuantity() - order.getQuantity());
+    return BookStatus::OK;
+}
+
+// Find order, read straight from its list node
+BookResult<Order*> OrderBook::tryFindOrder(OrderId orderId) const {
+    auto it = orderMap.find(orderId);
+    if (it == orderMap.end()) {
+        ++diagnostics.notFound;
+        return {BookStatus::NOT_FOUND, nullptr};
+    }
+    return {BookStatus::OK, it->second.position->get()};
+}
+
+std::shared_ptr<Order> OrderBook::findOrder(OrderId orderId) const {
+    auto it = orderMap.find(orderId);
+    if (it == orderMap.end()) {
+        ++diagnostics.notFound;
         return nullptr;
     }
+    return *it->second.position;
+}
+
+// Get the first order (time priority) at the best level of a side
+BookResult<Order*> OrderBook::tryBestBid() const {
+    const PriceLevel* level = bids.bestLevel();
+    if (!level) {
+        ++diagnostics.emptySide;
+        return {BookStatus::EMPTY_SIDE, nullptr};
+    }
+    return {BookStatus::OK, level->orders.front().get()};
+}
+
+BookResult<Order*> OrderBook::tryBestAsk() const {
+    const PriceLevel* level = asks.bestLevel();
+    if (!level) {
+        ++diagnostics.emptySide;
+        return {BookStatus::EMPTY_SIDE, nullptr};
+    }
+    return {BookStatus::OK, level->orders.front().get()};
 }
 
 // Get the highest bid
 std::shared_ptr<Order> OrderBook::getHighestBid() const {
-    try{
-        // Get first price level 
-        const auto& level = bids.begin() -> second;
-        if (bids.empty()) {
-            throw std::runtime_error("No bids.");
-        }
-        // Get first order (time priority)
-        return level.orders.empty() ? nullptr : level.orders.front();
-    }
-    catch (std::runtime_error& exception){
-        std::cerr << "Exception caught: " << exception.what() << "\n";
+    const PriceLevel* level = bids.bestLevel();
+    if (!level) {
+        ++diagnostics.emptySide;
         return nullptr;
     }
+    return level->orders.front();
 }
 
 // Get the lowest ask
 std::shared_ptr<Order> OrderBook::getLowestAsk() const {
-    try{
-        // Get first price level 
-        const auto& level = asks.begin() -> second;
+    const PriceLevel* level = asks.bestLevel();
+    if (!level) {
+        ++diagnostics.emptySide;
+        return nullptr;
+    }
+    return level->orders.front();
+}
+
+// Get diagnostic counters
+const BookDiagnostics& OrderBook::getDiagnostics() const {
+    return diagnostics;
+}
+
+// Sum level totals from the best level outwards
+Qty OrderBook::getDepth(bool isBuy, std::size_t maxLevels) const {
+    Qty depth;
+    std::size_t visited = 0;
+    auto accumulate = [&](const PriceLevel& level) {
+        depth += level.totalQuantity;
+        return ++visited < maxLevels;
+    };
+    if (maxLevels == 0) {
+        return depth;
+    }
+    if (isBuy) {
+        bids.forEachLevel(accumulate);
+    } else {
+        asks.forEachLevel(accumulate);
+    }
+    return depth;
+}
+
+// Depth imbalance between bids and asks
+double OrderBook::getImbalance(std::size_t maxLevels) const {
+    double bidDepth = getDepth(true, maxLevels).toDouble();
+    double askDepth = getDepth(false, maxLevels).toDouble();
+    if (bidDepth + askDepth <= 0.0) {
+        return 0.0;
+    }
+    return (bidDepth - askDepth) / (bidDepth + askDepth);
+}
+
+// Walk level totals until the quantity is covered
+SweepCost OrderBook::getSweepCost(bool isBuy, Qty quantity) const {
+    SweepCost cost{Qty(), 0.0};
+    auto sweep = [&](const PriceLevel& level) {
+        Qty take = std::min(quantity - cost.quantity, level.totalQuantity);
+        cost.quantity += take;
+        cost.notional += level.price.toDouble() * take.toDouble();
+        return cost.quantity < quantity;
+    };
+    if (isBuy) {
+        asks.forEachLevel(sweep);
+    } else {
+        bids.forEachLevel(sweep);
+    }
+    return cost;
+}
 
-        if (asks.empty()) {
-            throw std::runtime_error("No asks.");
+// Walk crossing level totals until the quantity is covered. Reserves count
+// too, since the sweep refills icebergs as their slices fill.
+Qty OrderBook::getCrossingDepth(bool isBuy, Price limit, Qty quantity, TraderId selfTrader,
+                                SelfTradePrevention prevention) const {
+    Qty depth;
+    auto accumulate = [&](const PriceLevel& level) {
+        if (isBuy ? level.price > limit : level.price < limit) {
+            return false;
+        }
+        if (prevention != SelfTradePrevention::NONE) {
+            // Quantity ahead of the first own order; refilled slices would
+            // queue behind it, so only visible quantity counts here
+            Qty ahead;
+            Qty own;
+            bool stopped = false;
+            for (const auto& order : level.orders) {
+                if (order->getTraderId() != selfTrader) {
+                    ahead += order->getQuantity();
+                    continue;
+                }
+                if (prevention != SelfTradePrevention::CANCEL_OLDEST) {
+                    stopped = true;
+                    break;
+                }
+                own += order->getTotalQuantity();
+            }
+            if (stopped) {
+                depth += ahead;
+                return false;
+            }
+            if (own > Qty()) {
+                // Cancelled own orders leave the rest of the level to fill
+                depth += level.totalQuantity + level.hiddenQuantity - own;
+                return depth < quantity;
+            }
         }
-        
-        // Get first order (time priority)
-        return level.orders.empty() ? nullptr : level.orders.front();;
+        depth += level.totalQuantity + level.hiddenQuantity;
+        return depth < quantity;
+    };
+    if (isBuy) {
+        asks.forEachLevel(accumulate);
+    } else {
+        bids.forEachLevel(accumulate);
     }
-    catch (std::runtime_error& exception){
-        std::cerr << "Exception caught: " << exception.what() << "\n";
-        return nullptr;
+    return std::min(depth, quantity);
+}
+
+// Clearing price from cumulative depth: walk candidate prices upwards, with
+// supply = asks at or below the price and demand = bids at or above it
+AuctionClearing OrderBook::getClearingPrice(Qty marketBuys, Qty marketSells) const {
+    std::vector<LevelView> askLevels;
+    std::vector<LevelView> bidLevels;
+    Qty bidTotal;
+    asks.forEachLevel([&](const PriceLevel& level) {
+        askLevels.push_back(LevelView{level.price, level.totalQuantity, level.orderCount});
+        return true;
+    });
+    bids.forEachLevel([&](const PriceLevel& level) {
+        bidLevels.push_back(LevelView{level.price, level.totalQuantity, level.orderCount});
+        bidTotal += level.totalQuantity;
+        return true;
+    });
+    std::reverse(bidLevels.begin(), bidLevels.end());
+
+    AuctionClearing best{Price(), Qty(), Qty()};
+    Qty supply = marketSells;
+    Qty bidsBelow;
+    std::size_t a = 0;
+    std::size_t b = 0;
+    while (a < askLevels.size() || b < bidLevels.size()) {
+        bool askNext = b == bidLevels.size() || (a < askLevels.size() && askLevels[a].price <= bidLevels[b].price);
+        Price price = askNext ? askLevels[a].price : bidLevels[b].price;
+        while (a < askLevels.size() && askLevels[a].price <= price) {
+            supply += askLevels[a++].quantity;
+        }
+        Qty demand = marketBuys + bidTotal - bidsBelow;
+        while (b < bidLevels.size() && bidLevels[b].price <= price) {
+            bidsBelow += bidLevels[b++].quantity;
+        }
+
+        Qty volume = std::min(demand, supply);
+        Qty imbalance = demand > supply ? demand - supply : supply - demand;
+        if (volume > best.volume || (volume > Qty() && volume == best.volume && imbalance < best.imbalance)) {
+            best = AuctionClearing{price, volume, imbalance};
+        }
+    }
+    return best;
+}
+
+// Copy level totals from the best level outwards
+std::size_t OrderBook::snapshotDepth(bool isBuy, std::size_t maxLevels, std::span<LevelView> out) const {
+    std::size_t limit = std::min(maxLevels, out.size());
+    std::size_t written = 0;
+    if (limit == 0) {
+        return 0;
+    }
+    auto copy = [&](const PriceLevel& level) {
+        out[written] = LevelView{level.price, level.totalQuantity, level.orderCount};
+        return ++written < limit;
+    };
+    if (isBuy) {
+        bids.forEachLevel(copy);
+    } else {
+        asks.forEachLevel(copy);
     }
+    return written;
 }
 
 // Check if book is empty
@@ -231,11 +467,16 @@ std::string OrderBook::toString() const {
     ss << "ORDER BOOK\n";
     ss << "==========\n";
     
-    // Print asks
+    // Print asks (worst first, so collect them best to worst and reverse)
     ss << "ASKS:\n";
-    for (auto it = asks.rbegin(); it != asks.rend(); ++it) {
-        ss << std::fixed << std::setprecision(2) << it->first << ": ";
-        for (const auto& order : it->second.orders) {
+    std::vector<const PriceLevel*> askLevels;
+    asks.forEachLevel([&askLevels](const PriceLevel& level) {
+        askLevels.push_back(&level);
+        return true;
+    });
+    for (auto it = askLevels.rbegin(); it != askLevels.rend(); ++it) {
+        ss << std::fixed << std::setprecision(2) << (*it)->price << ": ";
+        for (const auto& order : (*it)->orders) {
             ss << order->getQuantity() << " ";
         }
         ss << "\n";
@@ -245,13 +486,14 @@ std::string OrderBook::toString() const {
     
     // Print bids
     ss << "BIDS:\n";
-    for (const auto& [price, level] : bids) {
-        ss << std::fixed << std::setprecision(2) << price << ": ";
+    bids.forEachLevel([&ss](const PriceLevel& level) {
+        ss << std::fixed << std::setprecision(2) << level.price << ": ";
         for (const auto& order : level.orders) {
             ss << order->getQuantity() << " ";
         }
         ss << "\n";
-    }
+        return true;
+    });
     
     return ss.str();
 }
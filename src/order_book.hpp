@@ -1,55 +1,574 @@
 #pragma once
 
 #include "order.hpp"
+#include <algorithm>
 #include <map>
 #include <list>
+#include <deque>
 #include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 
 namespace trading {
 
+// FIFO queue of orders resting at one price
+using OrderQueue = std::list<std::shared_ptr<Order>>;
+
 // PriceLevel struct
 struct PriceLevel {
-    explicit PriceLevel(double p);
+    explicit PriceLevel(Price p);
+
+    Price price;
+    OrderQueue orders;  // Doubly-linked list
+    Qty totalQuantity;  // Running sum of resting quantity
+    Qty hiddenQuantity; // Running sum of iceberg reserves (not part of totalQuantity)
+    std::uint32_t orderCount = 0;
+
+    OrderQueue::iterator addOrder(std::shared_ptr<Order> order);
+    bool removeOrder(OrderId orderId);
+    void removeOrder(OrderQueue::iterator position);
+    void reduceOrder(OrderQueue::iterator position, Qty amount);
+
+    // Show an exhausted iceberg's next slice and move it to the back of the
+    // queue with a list splice (false when it has nothing left in reserve)
+    bool replenishOrder(OrderQueue::iterator position);
+
+    std::shared_ptr<Order> findOrder(OrderId orderId) const;
+};
+
+// Direct handle to a resting order: its side, level and list node
+struct OrderHandle {
+    bool isBuy;
+    PriceLevel* level;              // Book sides never move a level, so this stays valid
+    OrderQueue::iterator position;  // std::list iterators survive other inserts/erases
+};
+
+// Outcome of an order book operation
+enum class BookStatus {
+    OK,
+    NOT_FOUND,
+    EMPTY_SIDE,
+    INVALID_ORDER
+};
+
+// Status plus value (in the spirit of std::expected)
+template <typename T>
+struct BookResult {
+    BookStatus status;
+    T value;
 
-    double price;
-    std::list<std::shared_ptr<Order>> orders;  // Doubly-linked list
-    
-    void addOrder(std::shared_ptr<Order> order);
-    bool removeOrder(const std::string& orderId);
-    std::shared_ptr<Order> findOrder(const std::string& orderId) const;
+    explicit operator bool() const {
+        return status == BookStatus::OK;
+    }
+};
+
+// Counters of routine failures, read on demand instead of logged
+struct BookDiagnostics {
+    std::uint64_t notFound = 0;
+    std::uint64_t emptySide = 0;
+    std::uint64_t invalidOrders = 0;
+    std::uint64_t selfTradesPrevented = 0;
+};
+
+// What the matcher does when an incoming order meets a resting order from
+// the same trader
+enum class SelfTradePrevention {
+    NONE,           // Trade as usual
+    CANCEL_NEWEST,  // Cancel the rest of the incoming order
+    CANCEL_OLDEST,  // Cancel the resting order and keep matching
+    DECREMENT_BOTH  // Reduce both by the smaller quantity without trading
+};
+
+// Aggregated view of one price level for depth snapshots
+struct LevelView {
+    Price price;
+    Qty quantity;
+    std::uint32_t orderCount = 0;
+};
+
+// Result of sweeping a quantity through one side of the book
+struct SweepCost {
+    Qty quantity;     // Quantity that the side can fill
+    double notional;  // Sum of price * quantity over the fills
+};
+
+// Single price at which a call auction uncrosses the book
+struct AuctionClearing {
+    Price price;
+    Qty volume;       // Executable quantity at price (0 when nothing crosses)
+    Qty imbalance;    // |demand - supply| at price
+};
+
+// Best price, aggregate quantity and order count on one side of the book
+struct BookTop {
+    Price price;
+    Qty quantity;
+    std::uint32_t orderCount = 0;  // 0 when the side is empty
+};
+
+// Cached top of book for both sides
+struct TopOfBook {
+    BookTop bid;
+    BookTop ask;
+};
+
+// Book side backed by a binary tree keyed by price
+template <typename Compare>
+class MapBookSide {
+private:
+    std::map<Price, PriceLevel, Compare> levels;
+
+public:
+    // Find or create the level for a price
+    PriceLevel& getOrCreateLevel(Price price);
+
+    // Erase a level whose queue is empty
+    void eraseLevel(const PriceLevel& level);
+
+    // Get best level (nullptr if side is empty)
+    PriceLevel* bestLevel();
+    const PriceLevel* bestLevel() const;
+
+    // Check if side is empty
+    bool empty() const;
+
+    // Visit levels from best to worst until fn returns false
+    template <typename Fn>
+    void forEachLevel(Fn&& fn) const;
+};
+
+// Book side backed by a flat ladder of levels indexed by price tick.
+// The ladder grows at either end as new prices arrive, but only within a
+// window of WINDOW_TICKS ticks around the price it was centred on; levels
+// outside the window live in a small std::map instead, so a stray far price
+// costs one map node rather than a level per tick. The window re-centres on
+// the next price whenever the whole side is empty. A std::deque is used
+// because growth at the ends never moves existing levels, so OrderHandle
+// pointers stay valid.
+template <bool IsBid>
+class LadderBookSide {
+public:
+    static constexpr std::int64_t WINDOW_TICKS = std::int64_t(1) << 16;
+
+private:
+    using FarLevels = std::map<Price, PriceLevel, std::conditional_t<IsBid, std::greater<>, std::less<>>>;
+
+    std::deque<PriceLevel> levels;  // levels[i] holds tick baseTick + i
+    std::int64_t baseTick = 0;
+    std::int64_t windowBase = 0;    // The ladder never leaves [windowBase, windowBase + WINDOW_TICKS)
+    std::size_t bestIndex = 0;      // Cached index of the best non-empty level
+    std::size_t levelCount = 0;     // Number of non-empty ladder levels
+    FarLevels farLevels;            // Levels outside the window, best first
+
+    // Is index a better than index b for this side
+    static bool isBetter(std::size_t a, std::size_t b);
+
+    // Move the empty ladder so that it covers a new tick
+    void recentre(std::int64_t tick);
+
+    // Does the window cover a tick
+    bool inWindow(std::int64_t tick) const;
+
+public:
+    // Find or create the level for a price
+    PriceLevel& getOrCreateLevel(Price price);
+
+    // Mark a level as empty and advance the cached best index
+    void eraseLevel(const PriceLevel& level);
+
+    // Get best level (nullptr if side is empty)
+    PriceLevel* bestLevel();
+    const PriceLevel* bestLevel() const;
+
+    // Check if side is empty
+    bool empty() const;
+
+    // Visit levels from best to worst until fn returns false
+    template <typename Fn>
+    void forEachLevel(Fn&& fn) const;
 };
 
 // OrderBook class
 class OrderBook {
 private:
-    // Binary trees for price levels
-    std::map<double, PriceLevel, std::greater<>> bids;  // Highest bid
-    std::map<double, PriceLevel> asks;                  // Lowest ask
-    std::unordered_map<std::string, std::pair<bool, double>> orderMap;  // orderId -> (isBuy, price)
+    // Price levels per side: binary trees by default, flat tick ladders with TRADING_FLAT_LADDER
+#ifdef TRADING_FLAT_LADDER
+    using BidSide = LadderBookSide<true>;
+    using AskSide = LadderBookSide<false>;
+#else
+    using BidSide = MapBookSide<std::greater<>>;
+    using AskSide = MapBookSide<std::less<>>;
+#endif
+
+    BidSide bids;  // Highest bid first
+    AskSide asks;  // Lowest ask first
+    std::unordered_map<OrderId, OrderHandle> orderMap;  // orderId -> handle
+    TopOfBook top;  // Kept up to date on every add, remove and fill
+    mutable BookDiagnostics diagnostics;
+
+    // Unlink a resting order and drop its level if it empties
+    void unlinkOrder(std::unordered_map<OrderId, OrderHandle>::iterator it);
+
+    // Rebuild one side of the cached top from its best level
+    void refreshTop(bool isBuy);
+
+    // Sweep one side for match() and sweep(), reducing remaining by what is
+    // filled or self-trade cancelled; returns the quantity filled
+    template <typename Side, typename OnFill>
+    Qty sweepSide(Side& side, bool restingIsBuy, Qty& remaining, Price limit, OnFill& onFill,
+                  TraderId selfTrader, SelfTradePrevention prevention);
 
-    
 public:
-    // Add order
-    void addOrder(std::shared_ptr<Order> order);
-    
+    // Add order (INVALID_ORDER for null, non-limit or duplicate orders)
+    BookStatus addOrder(std::shared_ptr<Order> order);
+
     // Remove order
-    bool removeOrder(const std::string& orderId);
-    
-    // Find order
-    std::shared_ptr<Order> findOrder(const std::string& orderId) const;
-    
+    BookStatus tryRemoveOrder(OrderId orderId);
+    bool removeOrder(OrderId orderId);
+
+    // Find order (the try form returns a non-owning pointer)
+    BookResult<Order*> tryFindOrder(OrderId orderId) const;
+    std::shared_ptr<Order> findOrder(OrderId orderId) const;
+
+    // Fill part of a resting order (removed once nothing is left)
+    bool fillOrder(OrderId orderId, Qty filled);
+
+    // Shrink a resting order in place, keeping its queue position
+    // (INVALID_ORDER unless 0 < newQuantity < current total, which includes
+    // an iceberg's reserve; the reserve is cut before the visible slice)
+    BookStatus reduceQuantity(OrderId orderId, Qty newQuantity);
+
+    // Fill an incoming order against the opposite side, best level first and
+    // FIFO within each level, while the level price is no worse than limit.
+    // onFill(resting, price, quantity) runs before each resting order is
+    // reduced or popped. Exhausted orders are popped from the front of their
+    // queue and emptied levels are erased as the sweep passes them.
+    // Reduces the incoming quantity and returns the quantity filled.
+    // With self-trade prevention, a resting order from the incoming order's
+    // trader is handled per the mode instead of filled; any quantity the
+    // incoming order loses that way is taken off it without being filled.
+    template <typename OnFill>
+    Qty match(Order& incoming, Price limit, OnFill&& onFill,
+              SelfTradePrevention prevention = SelfTradePrevention::NONE);
+
+    // Take up to quantity from one side (isBuy sweeps the bids) the same way
+    // match() does, with no incoming order. Used to uncross call auctions.
+    template <typename OnFill>
+    Qty sweep(bool isBuy, Price limit, Qty quantity, OnFill&& onFill);
+
+    // Call-auction clearing price over the resting book plus unpriced market
+    // quantity: maximises executable volume, then minimises imbalance (ties
+    // go to the lowest price). One pass over cumulative level depth.
+    AuctionClearing getClearingPrice(Qty marketBuys = Qty(), Qty marketSells = Qty()) const;
+
     // Get highest bid
+    BookResult<Order*> tryBestBid() const;
     std::shared_ptr<Order> getHighestBid() const;
 
     // Get lowest ask
+    BookResult<Order*> tryBestAsk() const;
     std::shared_ptr<Order> getLowestAsk() const;
-    
+
+    // Get counters of not-found, empty-side and invalid-order outcomes
+    const BookDiagnostics& getDiagnostics() const;
+
+    // Get cached top of book (no allocation or refcount traffic)
+    TopOfBook getTopOfBook() const {
+        return top;
+    }
+
+    // Resting quantity over the best maxLevels levels of one side
+    Qty getDepth(bool isBuy, std::size_t maxLevels) const;
+
+    // (bid depth - ask depth) / (bid depth + ask depth) over maxLevels levels
+    double getImbalance(std::size_t maxLevels) const;
+
+    // Cost of taking quantity from the opposite side (isBuy sweeps the asks)
+    SweepCost getSweepCost(bool isBuy, Qty quantity) const;
+
+    // Opposite-side quantity an order at limit could take, counted from level
+    // totals including iceberg reserves and capped at quantity (isBuy sums
+    // asks at or below limit). With self-trade prevention, selfTrader's own
+    // orders are left out (CANCEL_OLDEST) or end the count where match()
+    // would stop filling (CANCEL_NEWEST, DECREMENT_BOTH), so crossing levels
+    // are then walked order by order.
+    Qty getCrossingDepth(bool isBuy, Price limit, Qty quantity, TraderId selfTrader = 0,
+                         SelfTradePrevention prevention = SelfTradePrevention::NONE) const;
+
+    // Write up to maxLevels best levels of one side into a caller-owned buffer.
+    // Returns the number of levels written; never allocates.
+    std::size_t snapshotDepth(bool isBuy, std::size_t maxLevels, std::span<LevelView> out) const;
+
     // Check if book is empty
     bool isEmpty() const;
-    
+
     // Display Order Book
     std::string toString() const;
 };
 
-}
\ No newline at end of file
+// OrderBook matching implementation
+
+template <typename OnFill>
+Qty OrderBook::match(Order& incoming, Price limit, OnFill&& onFill, SelfTradePrevention prevention) {
+    Qty remaining = incoming.getQuantity();
+    TraderId trader = incoming.getTraderId();
+    Qty filled = incoming.isBuyOrder()
+        ? sweepSide(asks, false, remaining, limit, onFill, trader, prevention)
+        : sweepSide(bids, true, remaining, limit, onFill, trader, prevention);
+    incoming.setQuantity(remaining);
+    return filled;
+}
+
+template <typename OnFill>
+Qty OrderBook::sweep(bool isBuy, Price limit, Qty quantity, OnFill&& onFill) {
+    if (isBuy) {
+        return sweepSide(bids, true, quantity, limit, onFill, 0, SelfTradePrevention::NONE);
+    }
+    return sweepSide(asks, false, quantity, limit, onFill, 0, SelfTradePrevention::NONE);
+}
+
+template <typename Side, typename OnFill>
+Qty OrderBook::sweepSide(Side& side, bool restingIsBuy, Qty& remaining, Price limit, OnFill& onFill,
+                          TraderId selfTrader, SelfTradePrevention prevention) {
+    Qty filled;
+    bool changed = false;
+
+    while (remaining > Qty()) {
+        PriceLevel* level = side.bestLevel();
+        if (!level || (restingIsBuy ? level->price < limit : level->price > limit)) {
+            break;
+        }
+
+        // Fill the level's queue front to back
+        while (remaining > Qty() && !level->orders.empty()) {
+            auto front = level->orders.begin();
+            Order& resting = **front;
+            Qty quantity = std::min(remaining, resting.getQuantity());
+            changed = true;
+
+            // Self-trade prevention costs one trader-ID compare per fill
+            if (prevention != SelfTradePrevention::NONE && resting.getTraderId() == selfTrader) {
+                ++diagnostics.selfTradesPrevented;
+                if (prevention == SelfTradePrevention::CANCEL_NEWEST) {
+                    remaining = Qty();
+                    break;
+                }
+                if (prevention == SelfTradePrevention::CANCEL_OLDEST) {
+                    orderMap.erase(resting.getId());
+                    level->removeOrder(front);
+                    continue;
+                }
+                remaining -= quantity;
+                bool exhausted = quantity == resting.getQuantity();
+                level->reduceOrder(front, quantity);
+                if (exhausted && !level->replenishOrder(front)) {
+                    orderMap.erase(resting.getId());
+                    level->removeOrder(front);
+                }
+                continue;
+            }
+
+            onFill(resting, level->price, quantity);
+            remaining -= quantity;
+            filled += quantity;
+
+            bool exhausted = quantity == resting.getQuantity();
+            level->reduceOrder(front, quantity);
+            if (exhausted && !level->replenishOrder(front)) {
+                orderMap.erase(resting.getId());
+                level->removeOrder(front);
+            }
+        }
+
+        if (level->orders.empty()) {
+            side.eraseLevel(*level);
+        }
+    }
+
+    if (changed) {
+        refreshTop(restingIsBuy);
+    }
+    return filled;
+}
+
+// MapBookSide implementation
+
+template <typename Compare>
+PriceLevel& MapBookSide<Compare>::getOrCreateLevel(Price price) {
+    return levels.try_emplace(price, price).first->second;
+}
+
+template <typename Compare>
+void MapBookSide<Compare>::eraseLevel(const PriceLevel& level) {
+    levels.erase(level.price);
+}
+
+template <typename Compare>
+PriceLevel* MapBookSide<Compare>::bestLevel() {
+    return levels.empty() ? nullptr : &levels.begin()->second;
+}
+
+template <typename Compare>
+const PriceLevel* MapBookSide<Compare>::bestLevel() const {
+    return levels.empty() ? nullptr : &levels.begin()->second;
+}
+
+template <typename Compare>
+bool MapBookSide<Compare>::empty() const {
+    return levels.empty();
+}
+
+template <typename Compare>
+template <typename Fn>
+void MapBookSide<Compare>::forEachLevel(Fn&& fn) const {
+    for (const auto& [price, level] : levels) {
+        if (!fn(level)) {
+            return;
+        }
+    }
+}
+
+// LadderBookSide implementation
+
+template <bool IsBid>
+bool LadderBookSide<IsBid>::isBetter(std::size_t a, std::size_t b) {
+    return IsBid ? a > b : a < b;
+}
+
+template <bool IsBid>
+void LadderBookSide<IsBid>::recentre(std::int64_t tick) {
+    windowBase = tick - WINDOW_TICKS / 2;
+    baseTick = tick - static_cast<std::int64_t>(levels.size() / 2);
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        levels[i].price = Price::fromRaw(baseTick + static_cast<std::int64_t>(i));
+    }
+}
+
+template <bool IsBid>
+PriceLevel& LadderBookSide<IsBid>::getOrCreateLevel(Price price) {
+    std::int64_t tick = price.raw();
+
+    if (levels.empty()) {
+        baseTick = tick;
+        windowBase = tick - WINDOW_TICKS / 2;
+        levels.emplace_back(price);
+    }
+    std::int64_t top = baseTick + static_cast<std::int64_t>(levels.size());
+    if (levelCount == 0 && farLevels.empty() && (tick < baseTick || tick >= top)) {
+        recentre(tick);
+        top = baseTick + static_cast<std::int64_t>(levels.size());
+    }
+
+    // Far prices never stretch the ladder
+    if (!inWindow(tick)) {
+        return farLevels.try_emplace(price, price).first->second;
+    }
+
+    // Extend the ladder until it covers the tick
+    while (tick < baseTick) {
+        --baseTick;
+        levels.emplace_front(Price::fromRaw(baseTick));
+        ++bestIndex;
+    }
+    while (tick >= top) {
+        levels.emplace_back(Price::fromRaw(top));
+        ++top;
+    }
+
+    std::size_t index = static_cast<std::size_t>(tick - baseTick);
+    PriceLevel& level = levels[index];
+    if (level.orders.empty()) {
+        if (levelCount == 0 || isBetter(index, bestIndex)) {
+            bestIndex = index;
+        }
+        ++levelCount;
+    }
+    return level;
+}
+
+template <bool IsBid>
+void LadderBookSide<IsBid>::eraseLevel(const PriceLevel& level) {
+    // The window only moves while the map is empty, so map levels are outside it
+    if (!inWindow(level.price.raw())) {
+        farLevels.erase(level.price);
+        return;
+    }
+
+    --levelCount;
+    if (levelCount == 0 || &level != &levels[bestIndex]) {
+        return;
+    }
+
+    // Walk away from the old best until the next non-empty level
+    do {
+        bestIndex = IsBid ? bestIndex - 1 : bestIndex + 1;
+    } while (levels[bestIndex].orders.empty());
+}
+
+template <bool IsBid>
+bool LadderBookSide<IsBid>::inWindow(std::int64_t tick) const {
+    return tick >= windowBase && tick < windowBase + WINDOW_TICKS;
+}
+
+template <bool IsBid>
+PriceLevel* LadderBookSide<IsBid>::bestLevel() {
+    return const_cast<PriceLevel*>(std::as_const(*this).bestLevel());
+}
+
+template <bool IsBid>
+const PriceLevel* LadderBookSide<IsBid>::bestLevel() const {
+    const PriceLevel* ladder = levelCount == 0 ? nullptr : &levels[bestIndex];
+    if (farLevels.empty()) {
+        return ladder;
+    }
+    const PriceLevel* far = &farLevels.begin()->second;
+    if (!ladder || (IsBid ? far->price > ladder->price : far->price < ladder->price)) {
+        return far;
+    }
+    return ladder;
+}
+
+template <bool IsBid>
+bool LadderBookSide<IsBid>::empty() const {
+    return levelCount == 0 && farLevels.empty();
+}
+
+template <bool IsBid>
+template <typename Fn>
+void LadderBookSide<IsBid>::forEachLevel(Fn&& fn) const {
+    // Merge the ladder and the far levels, both walked best first
+    std::size_t remaining = levelCount;
+    std::size_t index = bestIndex;
+    auto nextLadder = [&]() -> const PriceLevel* {
+        while (remaining > 0) {
+            const PriceLevel& level = levels[index];
+            index = IsBid ? index - 1 : index + 1;
+            if (!level.orders.empty()) {
+                --remaining;
+                return &level;
+            }
+        }
+        return nullptr;
+    };
+
+    const PriceLevel* ladder = nextLadder();
+    auto far = farLevels.begin();
+    while (ladder || far != farLevels.end()) {
+        const PriceLevel* level = ladder;
+        if (far != farLevels.end() && (!ladder || (IsBid ? far->first > ladder->price : far->first < ladder->price))) {
+            level = &far->second;
+            ++far;
+        } else {
+            ladder = nextLadder();
+        }
+        if (!fn(*level)) {
+            return;
+        }
+    }
+}
+
+}
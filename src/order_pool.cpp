@@ -0,0 +1,86 @@
+#include "order_pool.hpp"
+
+namespace trading {
+
+// Constructor
+OrderPool::OrderPool(std::size_t slotsPerSlab): slotsPerSlab(slotsPerSlab == 0 ? 1 : slotsPerSlab) {
+    grow();
+}
+
+// Create a pool on the heap so it can outlive its owner
+OrderPool* OrderPool::create(std::size_t slotsPerSlab) {
+    return new OrderPool(slotsPerSlab);
+}
+
+// Owner gives up the pool; orders still alive keep it until they are destroyed
+void OrderPool::release() {
+    bool unused;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+        unused = inUse == 0;
+    }
+    if (unused) {
+        delete this;
+    }
+}
+
+// Add a slab and push all its slots onto the free list
+void OrderPool::grow() {
+    slabs.push_back(std::make_unique<Slot[]>(slotsPerSlab));
+    Slot* slab = slabs.back().get();
+    for (std::size_t i = slotsPerSlab; i > 0; --i) {
+        auto* slot = reinterpret_cast<FreeSlot*>(&slab[i - 1]);
+        slot->next = freeList;
+        freeList = slot;
+    }
+}
+
+// Pop a slot from the free list
+void* OrderPool::allocate(std::size_t bytes) {
+    if (bytes > SLOT_SIZE) {
+        return ::operator new(bytes);
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeList) {
+        grow();
+    }
+    FreeSlot* slot = freeList;
+    freeList = slot->next;
+    ++inUse;
+    return slot;
+}
+
+// Push a slot back onto the free list
+void OrderPool::deallocate(void* ptr, std::size_t bytes) {
+    if (bytes > SLOT_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+    bool lastSlot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto* slot = static_cast<FreeSlot*>(ptr);
+        slot->next = freeList;
+        freeList = slot;
+        --inUse;
+        lastSlot = released && inUse == 0;
+    }
+    if (lastSlot) {
+        delete this;
+    }
+}
+
+// Total number of slots
+std::size_t OrderPool::slotCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return slabs.size() * slotsPerSlab;
+}
+
+// Number of slots holding live orders
+std::size_t OrderPool::slotsInUse() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return inUse;
+}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace trading {
+
+// Slab allocator that recycles fixed-size slots for order storage.
+// Slabs are only ever added, so once the pool has grown to the peak number of
+// live orders, creating and destroying orders no longer touches malloc.
+// A mutex guards the free list, since shard threads release filled orders
+// concurrently; it is uncontended in single-threaded use.
+class OrderPool {
+public:
+    // Slot size: fits any order together with its shared_ptr control block
+    static constexpr std::size_t SLOT_SIZE = 256;
+
+    // Create a pool (owner must call release() instead of deleting it)
+    static OrderPool* create(std::size_t slotsPerSlab = 1024);
+
+    // Owner gives up the pool; storage is freed once every slot is returned
+    void release();
+
+    // Take/return a slot (requests larger than a slot fall back to operator new)
+    void* allocate(std::size_t bytes);
+    void deallocate(void* ptr, std::size_t bytes);
+
+    // Pool statistics
+    std::size_t slotCount() const;
+    std::size_t slotsInUse() const;
+
+private:
+    // Free slots are chained through their own storage
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    struct alignas(std::max_align_t) Slot {
+        std::byte storage[SLOT_SIZE];
+    };
+
+    std::size_t slotsPerSlab;
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    FreeSlot* freeList = nullptr;
+    std::size_t inUse = 0;
+    bool released = false;
+    mutable std::mutex mutex;
+
+    explicit OrderPool(std::size_t slotsPerSlab);
+
+    // Add a slab and thread its slots onto the free list
+    void grow();
+};
+
+// Standard allocator over an OrderPool, for std::allocate_shared
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(OrderPool* pool): pool(pool) {
+    }
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other): pool(other.pool) {
+    }
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(pool->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) {
+        pool->deallocate(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const {
+        return pool == other.pool;
+    }
+
+    OrderPool* pool;
+};
+
+}
@@ -0,0 +1,75 @@
+#include "stop_index.hpp"
+
+namespace trading {
+
+// Hold an untriggered stop order
+bool StopIndex::add(std::shared_ptr<Order> order) {
+    auto* condition = dynamic_cast<StopCondition*>(order.get());
+    if (!condition || condition->isTriggered()) {
+        return false;
+    }
+    auto [entry, inserted] = handles.try_emplace(order->getId());
+    if (!inserted) {
+        return false;
+    }
+
+    Price stopPrice = condition->getStopPrice();
+    bool isBuy = order->isBuyOrder();
+    entry->second.isBuy = isBuy;
+    if (isBuy) {
+        entry->second.buy = buyStops.emplace(stopPrice, Entry{std::move(order), condition});
+    } else {
+        entry->second.sell = sellStops.emplace(stopPrice, Entry{std::move(order), condition});
+    }
+    return true;
+}
+
+// Drop a held stop by ID
+bool StopIndex::remove(OrderId orderId) {
+    auto it = handles.find(orderId);
+    if (it == handles.end()) {
+        return false;
+    }
+    if (it->second.isBuy) {
+        buyStops.erase(it->second.buy);
+    } else {
+        sellStops.erase(it->second.sell);
+    }
+    handles.erase(it);
+    return true;
+}
+
+// Release the prefix of each side that lastPrice reaches
+void StopIndex::release(Price lastPrice, std::vector<std::shared_ptr<Order>>& out) {
+    // Buy stops at or below the trade price
+    auto buyEnd = buyStops.upper_bound(lastPrice);
+    for (auto it = buyStops.begin(); it != buyEnd; ++it) {
+        it->second.condition->trigger();
+        handles.erase(it->second.order->getId());
+        out.push_back(std::move(it->second.order));
+    }
+    buyStops.erase(buyStops.begin(), buyEnd);
+
+    // Sell stops at or above the trade price
+    auto sellEnd = sellStops.upper_bound(lastPrice);
+    for (auto it = sellStops.begin(); it != sellEnd; ++it) {
+        it->second.condition->trigger();
+        handles.erase(it->second.order->getId());
+        out.push_back(std::move(it->second.order));
+    }
+    sellStops.erase(sellStops.begin(), sellEnd);
+}
+
+bool StopIndex::contains(OrderId orderId) const {
+    return handles.count(orderId) != 0;
+}
+
+std::size_t StopIndex::size() const {
+    return handles.size();
+}
+
+bool StopIndex::empty() const {
+    return handles.empty();
+}
+
+}
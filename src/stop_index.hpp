@@ -0,0 +1,54 @@
+#pragma once
+
+#include "order.hpp"
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace trading {
+
+// Untriggered stop and stop-limit orders, sorted by stop price on each side.
+// Buy stops are kept lowest stop first and sell stops highest first, so the
+// stops a trade price reaches always form a prefix of their side: releasing
+// them costs O(log n) plus the number released, however many stops are held.
+// Equal stop prices release in the order they were added.
+class StopIndex {
+public:
+    // Hold an untriggered stop order (false if it is not one, or is already held)
+    bool add(std::shared_ptr<Order> order);
+
+    // Drop a held stop by ID
+    bool remove(OrderId orderId);
+
+    // Trigger every stop reached by a trade at lastPrice and append it to out,
+    // buy stops before sell stops, each in stop-price then arrival order
+    void release(Price lastPrice, std::vector<std::shared_ptr<Order>>& out);
+
+    bool contains(OrderId orderId) const;
+    std::size_t size() const;
+    bool empty() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<Order> order;
+        StopCondition* condition;  // The same object as order, seen as a stop
+    };
+    using BuyStops = std::multimap<Price, Entry>;
+    using SellStops = std::multimap<Price, Entry, std::greater<Price>>;
+
+    // Where a held stop lives, for O(1) removal by ID
+    struct Handle {
+        bool isBuy;
+        BuyStops::iterator buy;
+        SellStops::iterator sell;
+    };
+
+    BuyStops buyStops;
+    SellStops sellStops;
+    std::unordered_map<OrderId, Handle> handles;
+};
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "clock.hpp"
+#include "order.hpp"
+#include <string>
+
+namespace trading {
+
+// Trade struct
+struct Trade {
+    SymbolId symbol = 0;
+    OrderId buyOrderId;
+    OrderId sellOrderId;
+    TraderId buyTraderId;
+    TraderId sellTraderId;
+    Price price;
+    Qty quantity;
+    bool aggressorIsBuy = false;  // Side of the incoming order that took liquidity
+    Timestamp timestamp = 0;  // Monotonic time of execution
+
+    std::string toString() const;
+};
+
+}
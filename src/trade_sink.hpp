@@ -0,0 +1,46 @@
+#pragma once
+
+#include "trade.hpp"
+#include <utility>
+#include <vector>
+
+namespace trading {
+
+// Receives each trade as the matcher executes it
+class TradeSink {
+public:
+    virtual ~TradeSink() = default;
+
+    virtual void onTrade(const Trade& trade) = 0;
+};
+
+// Appends trades to a caller-owned vector (clear it between submissions to reuse its capacity)
+class VectorTradeSink : public TradeSink {
+public:
+    explicit VectorTradeSink(std::vector<Trade>& trades): trades(trades) {
+    }
+
+    void onTrade(const Trade& trade) override {
+        trades.push_back(trade);
+    }
+
+private:
+    std::vector<Trade>& trades;
+};
+
+// Forwards trades to a callable
+template <typename Fn>
+class CallbackTradeSink : public TradeSink {
+public:
+    explicit CallbackTradeSink(Fn fn): fn(std::move(fn)) {
+    }
+
+    void onTrade(const Trade& trade) override {
+        fn(trade);
+    }
+
+private:
+    Fn fn;
+};
+
+}
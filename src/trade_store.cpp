@@ -0,0 +1,96 @@
+#include "trade_store.hpp"
+#include <algorithm>
+
+namespace trading {
+
+// Append a trade, starting a new chunk when the last one is full
+void TradeStore::append(const Trade& trade) {
+    std::size_t slot = count % CHUNK_SIZE;
+    if (slot == 0 && count / CHUNK_SIZE == chunks.size()) {
+        chunks.push_back(std::make_unique<Chunk>());
+    }
+    Chunk& chunk = *chunks[count / CHUNK_SIZE];
+    chunk.symbols[slot] = trade.symbol;
+    chunk.buyOrderIds[slot] = trade.buyOrderId;
+    chunk.sellOrderIds[slot] = trade.sellOrderId;
+    chunk.buyTraderIds[slot] = trade.buyTraderId;
+    chunk.sellTraderIds[slot] = trade.sellTraderId;
+    chunk.prices[slot] = trade.price;
+    chunk.quantities[slot] = trade.quantity;
+    chunk.aggressorIsBuy[slot] = trade.aggressorIsBuy ? 1 : 0;
+    chunk.timestamps[slot] = trade.timestamp;
+    ++count;
+}
+
+// Number of trades
+std::size_t TradeStore::size() const {
+    return count;
+}
+
+bool TradeStore::empty() const {
+    return count == 0;
+}
+
+// Rebuild a trade row from the columns
+Trade TradeStore::operator[](std::size_t index) const {
+    const Chunk& chunk = *chunks[index / CHUNK_SIZE];
+    std::size_t slot = index % CHUNK_SIZE;
+    Trade trade;
+    trade.symbol = chunk.symbols[slot];
+    trade.buyOrderId = chunk.buyOrderIds[slot];
+    trade.sellOrderId = chunk.sellOrderIds[slot];
+    trade.buyTraderId = chunk.buyTraderIds[slot];
+    trade.sellTraderId = chunk.sellTraderIds[slot];
+    trade.price = chunk.prices[slot];
+    trade.quantity = chunk.quantities[slot];
+    trade.aggressorIsBuy = chunk.aggressorIsBuy[slot] != 0;
+    trade.timestamp = chunk.timestamps[slot];
+    return trade;
+}
+
+Trade TradeStore::back() const {
+    return (*this)[count - 1];
+}
+
+// Allocate chunks up front
+void TradeStore::reserve(std::size_t additional) {
+    std::size_t needed = (count + additional + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    while (chunks.size() < needed) {
+        chunks.push_back(std::make_unique<Chunk>());
+    }
+}
+
+// Drop all trades and chunks
+void TradeStore::clear() {
+    chunks.clear();
+    count = 0;
+}
+
+// Number of chunks holding trades (reserved chunks are not counted)
+std::size_t TradeStore::chunkCount() const {
+    return (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+}
+
+// Columns of one chunk, trimmed to the trades it holds
+TradeColumns TradeStore::columns(std::size_t chunkIndex) const {
+    const Chunk& chunk = *chunks[chunkIndex];
+    std::size_t used = std::min(CHUNK_SIZE, count - chunkIndex * CHUNK_SIZE);
+    return TradeColumns{
+        std::span<const SymbolId>(chunk.symbols.data(), used),
+        std::span<const OrderId>(chunk.buyOrderIds.data(), used),
+        std::span<const OrderId>(chunk.sellOrderIds.data(), used),
+        std::span<const TraderId>(chunk.buyTraderIds.data(), used),
+        std::span<const TraderId>(chunk.sellTraderIds.data(), used),
+        std::span<const Price>(chunk.prices.data(), used),
+        std::span<const Qty>(chunk.quantities.data(), used),
+        std::span<const std::uint8_t>(chunk.aggressorIsBuy.data(), used),
+        std::span<const Timestamp>(chunk.timestamps.data(), used)
+    };
+}
+
+// Bytes held by chunk storage
+std::size_t TradeStore::bytesReserved() const {
+    return chunks.size() * sizeof(Chunk);
+}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "trade.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace trading {
+
+// Columns of one chunk of trades (all spans have the same length)
+struct TradeColumns {
+    std::span<const SymbolId> symbols;
+    std::span<const OrderId> buyOrderIds;
+    std::span<const OrderId> sellOrderIds;
+    std::span<const TraderId> buyTraderIds;
+    std::span<const TraderId> sellTraderIds;
+    std::span<const Price> prices;
+    std::span<const Qty> quantities;
+    std::span<const std::uint8_t> aggressorIsBuy;  // 1 when the buyer took liquidity
+    std::span<const Timestamp> timestamps;
+
+    std::size_t size() const {
+        return prices.size();
+    }
+};
+
+// Append-only trade record stored column by column.
+// Trades are kept in fixed-size chunks, so growth allocates one chunk at a time
+// and never moves or copies earlier trades. Analytics read the columns of each
+// chunk as contiguous arrays through forEachChunk.
+class TradeStore {
+public:
+    static constexpr std::size_t CHUNK_SIZE = 1024;
+
+    // Append a trade
+    void append(const Trade& trade);
+
+    // Number of trades
+    std::size_t size() const;
+    bool empty() const;
+
+    // Rebuild a trade row (index must be below size())
+    Trade operator[](std::size_t index) const;
+    Trade back() const;
+
+    // Allocate chunks up front so the next `additional` appends allocate nothing
+    void reserve(std::size_t additional);
+
+    // Drop all trades and chunks
+    void clear();
+
+    // Number of chunks and the columns of one of them
+    std::size_t chunkCount() const;
+    TradeColumns columns(std::size_t chunkIndex) const;
+
+    // Visit the columns of every chunk in trade order
+    template <typename Fn>
+    void forEachChunk(Fn&& fn) const {
+        for (std::size_t i = 0; i < chunkCount(); ++i) {
+            fn(columns(i));
+        }
+    }
+
+    // Bytes held by chunk storage
+    std::size_t bytesReserved() const;
+
+private:
+    struct Chunk {
+        std::array<SymbolId, CHUNK_SIZE> symbols;
+        std::array<OrderId, CHUNK_SIZE> buyOrderIds;
+        std::array<OrderId, CHUNK_SIZE> sellOrderIds;
+        std::array<TraderId, CHUNK_SIZE> buyTraderIds;
+        std::array<TraderId, CHUNK_SIZE> sellTraderIds;
+        std::array<Price, CHUNK_SIZE> prices;
+        std::array<Qty, CHUNK_SIZE> quantities;
+        std::array<std::uint8_t, CHUNK_SIZE> aggressorIsBuy;
+        std::array<Timestamp, CHUNK_SIZE> timestamps;
+    };
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::size_t count = 0;
+};
+
+}
@@ -1,5 +1,6 @@
 #include "trader.hpp"
 #include "exchange.hpp"
+#include <atomic>
 #include <iostream>
 
 namespace trading {
@@ -9,20 +10,116 @@ namespace trading {
 // Constructor
 Trader::Trader(Exchange* exchange):
     exchange(exchange) {
-        static unsigned int nextTraderId = 1;
-        id = "TRD-" + std::to_string(nextTraderId++);
+        static std::atomic<TraderId> nextTraderId{1};
+        id = nextTraderId.fetch_add(1, std::memory_order_relaxed);
 }
 
 // Create limit order
-std::shared_ptr<LimitOrder> Trader::createLimitOrder(double price, double quantity, bool isBuy){
+std::shared_ptr<LimitOrder> Trader::createLimitOrder(Price price, Qty quantity, bool isBuy, SymbolId symbol){
     try{
-        if (price <= 0){
+        if (price <= Price()){
             throw std::invalid_argument("Limit price must be greater than zero.");
         }
-        if (quantity <= 0){
+        if (quantity <= Qty()){
             throw std::invalid_argument("Order quantity must be greater than zero.");
         }
-        auto order = std::make_shared<LimitOrder>(id, price, quantity, isBuy);
+        auto order = exchange ? exchange->createOrder<LimitOrder>(id, price, quantity, isBuy, symbol)
+                              : std::make_shared<LimitOrder>(id, price, quantity, isBuy, symbol);
+        return order;
+    }
+    catch (std::invalid_argument& exception){
+        std::cerr << "Exception caught: " << exception.what() << "\n";
+        return nullptr;
+    }
+}
+
+// Create immediate-or-cancel order
+std::shared_ptr<IocOrder> Trader::createIocOrder(Price price, Qty quantity, bool isBuy, SymbolId symbol) {
+    try{
+        if (price <= Price()){
+            throw std::invalid_argument("Limit price must be greater than zero.");
+        }
+        if (quantity <= Qty()){
+            throw std::invalid_argument("Order quantity must be greater than zero.");
+        }
+        auto order = exchange ? exchange->createOrder<IocOrder>(id, price, quantity, isBuy, symbol)
+                              : std::make_shared<IocOrder>(id, price, quantity, isBuy, symbol);
+        return order;
+    }
+    catch (std::invalid_argument& exception){
+        std::cerr << "Exception caught: " << exception.what() << "\n";
+        return nullptr;
+    }
+}
+
+// Create fill-or-kill order
+std::shared_ptr<FokOrder> Trader::createFokOrder(Price price, Qty quantity, bool isBuy, SymbolId symbol) {
+    try{
+        if (price <= Price()){
+            throw std::invalid_argument("Limit price must be greater than zero.");
+        }
+        if (quantity <= Qty()){
+            throw std::invalid_argument("Order quantity must be greater than zero.");
+        }
+        auto order = exchange ? exchange->createOrder<FokOrder>(id, price, quantity, isBuy, symbol)
+                              : std::make_shared<FokOrder>(id, price, quantity, isBuy, symbol);
+        return order;
+    }
+    catch (std::invalid_argument& exception){
+        std::cerr << "Exception caught: " << exception.what() << "\n";
+        return nullptr;
+    }
+}
+
+// Create iceberg order
+std::shared_ptr<IcebergOrder> Trader::createIcebergOrder(Price price, Qty quantity, Qty displaySize, bool isBuy, SymbolId symbol) {
+    try{
+        if (price <= Price()){
+            throw std::invalid_argument("Limit price must be greater than zero.");
+        }
+        if (quantity <= Qty() || displaySize <= Qty()){
+            throw std::invalid_argument("Order and display quantities must be greater than zero.");
+        }
+        auto order = exchange ? exchange->createOrder<IcebergOrder>(id, price, quantity, displaySize, isBuy, symbol)
+                              : std::make_shared<IcebergOrder>(id, price, quantity, displaySize, isBuy, symbol);
+        return order;
+    }
+    catch (std::invalid_argument& exception){
+        std::cerr << "Exception caught: " << exception.what() << "\n";
+        return nullptr;
+    }
+}
+
+// Create stop order
+std::shared_ptr<StopOrder> Trader::createStopOrder(Price stopPrice, Qty quantity, bool isBuy, SymbolId symbol) {
+    try{
+        if (stopPrice <= Price()){
+            throw std::invalid_argument("Stop price must be greater than zero.");
+        }
+        if (quantity <= Qty()){
+            throw std::invalid_argument("Order quantity must be greater than zero.");
+        }
+        auto order = exchange ? exchange->createOrder<StopOrder>(id, stopPrice, quantity, isBuy, symbol)
+                              : std::make_shared<StopOrder>(id, stopPrice, quantity, isBuy, symbol);
+        return order;
+    }
+    catch (std::invalid_argument& exception){
+        std::cerr << "Exception caught: " << exception.what() << "\n";
+        return nullptr;
+    }
+}
+
+// Create stop-limit order
+std::shared_ptr<StopLimitOrder> Trader::createStopLimitOrder(Price stopPrice, Price price, Qty quantity, bool isBuy, SymbolId symbol) {
+    try{
+        if (stopPrice <= Price() || price <= Price()){
+            throw std::invalid_argument("Stop and limit prices must be greater than zero.");
+        }
+        if (quantity <= Qty()){
+            throw std::invalid_argument("Order quantity must be greater than zero.");
+        }
+        auto order = exchange ? exchange->createOrder<StopLimitOrder>(id, stopPrice, price, quantity, isBuy, symbol)
+                              : std::make_shared<StopLimitOrder>(id, stopPrice, price, quantity, isBuy, symbol);
         return order;
     }
     catch (std::invalid_argument& exception){
@@ -32,12 +129,13 @@ std::shared_ptr<LimitOrder> Trader::createLimitOrder(double price, double quanti
 }
 
 // Create market order
-std::shared_ptr<MarketOrder> Trader::createMarketOrder(double quantity, bool isBuy) {
+std::shared_ptr<MarketOrder> Trader::createMarketOrder(Qty quantity, bool isBuy, SymbolId symbol) {
     try{
-        if (quantity <= 0){
+        if (quantity <= Qty()){
             throw std::invalid_argument("Order quantity must be greater than zero.");
         }
-        auto order = std::make_shared<MarketOrder>(id, quantity, isBuy);
+        auto order = exchange ? exchange->createOrder<MarketOrder>(id, quantity, isBuy, symbol)
+                              : std::make_shared<MarketOrder>(id, quantity, isBuy, symbol);
         return order;
     }
     catch (std::invalid_argument& exception){
@@ -47,20 +145,28 @@ std::shared_ptr<MarketOrder> Trader::createMarketOrder(double quantity, bool isB
 }
 
 // Cancel limit order
-bool Trader::cancelOrder(const std::string& orderId) {
-    return exchange->cancelOrder(orderId);
+bool Trader::cancelOrder(OrderId orderId) {
+    return cancelOrder(0, orderId);
+}
+
+bool Trader::cancelOrder(SymbolId symbol, OrderId orderId) {
+    return exchange->cancelOrder(symbol, orderId);
 }
 
 // Modify limit order
-bool Trader::modifyOrder(const std::string& orderId, double newPrice, double newQuantity) {
+bool Trader::modifyOrder(OrderId orderId, Price newPrice, Qty newQuantity) {
+    return modifyOrder(0, orderId, newPrice, newQuantity);
+}
+
+bool Trader::modifyOrder(SymbolId symbol, OrderId orderId, Price newPrice, Qty newQuantity) {
     try{
-        if (newPrice <= 0){
+        if (newPrice <= Price()){
             throw std::invalid_argument("Limit price must be greater than zero.");
         }
-        if (newQuantity <= 0){
+        if (newQuantity <= Qty()){
             throw std::invalid_argument("Order quantity must be greater than zero.");
         }
-        return exchange->modifyOrder(orderId, newPrice, newQuantity);
+        return exchange->modifyOrder(symbol, orderId, newPrice, newQuantity);
     }
     catch (std::invalid_argument& exception){
         std::cerr << "Exception caught: " << exception.what() << "\n";
@@ -69,7 +175,7 @@ bool Trader::modifyOrder(const std::string& orderId, double newPrice, double new
 }
 
 // Get id 
-const std::string& Trader::getId() const {
+TraderId Trader::getId() const {
     return id;
 }
 
@@ -12,7 +12,7 @@ class Exchange;
 // Trader class
 class Trader {
 private:
-    std::string id; 
+    TraderId id;
     Exchange* exchange; 
 
 public:
@@ -20,19 +20,32 @@ public:
     Trader(Exchange* exchange);
     
     // Create limit order
-    std::shared_ptr<LimitOrder> createLimitOrder(double price, double quantity, bool isBuy);
+    std::shared_ptr<LimitOrder> createLimitOrder(Price price, Qty quantity, bool isBuy, SymbolId symbol = 0);
+
+    // Create immediate-or-cancel / fill-or-kill orders
+    std::shared_ptr<IocOrder> createIocOrder(Price price, Qty quantity, bool isBuy, SymbolId symbol = 0);
+    std::shared_ptr<FokOrder> createFokOrder(Price price, Qty quantity, bool isBuy, SymbolId symbol = 0);
+
+    // Create iceberg order showing at most displaySize of quantity
+    std::shared_ptr<IcebergOrder> createIcebergOrder(Price price, Qty quantity, Qty displaySize, bool isBuy, SymbolId symbol = 0);
+
+    // Create stop (market once triggered) / stop-limit orders
+    std::shared_ptr<StopOrder> createStopOrder(Price stopPrice, Qty quantity, bool isBuy, SymbolId symbol = 0);
+    std::shared_ptr<StopLimitOrder> createStopLimitOrder(Price stopPrice, Price price, Qty quantity, bool isBuy, SymbolId symbol = 0);
 
     // Create market order
-    std::shared_ptr<MarketOrder> createMarketOrder(double quantity, bool isBuy);
+    std::shared_ptr<MarketOrder> createMarketOrder(Qty quantity, bool isBuy, SymbolId symbol = 0);
     
-    // Cancel limit order
-    bool cancelOrder(const std::string& orderId);
+    // Cancel limit order (symbol 0 unless given, in the same order as Exchange)
+    bool cancelOrder(OrderId orderId);
+    bool cancelOrder(SymbolId symbol, OrderId orderId);
 
-    // Modify limit order
-    bool modifyOrder(const std::string& orderId, double newQuantity, double newPrice);
+    // Modify limit order (symbol 0 unless given, in the same order as Exchange)
+    bool modifyOrder(OrderId orderId, Price newPrice, Qty newQuantity);
+    bool modifyOrder(SymbolId symbol, OrderId orderId, Price newPrice, Qty newQuantity);
     
     // Get id 
-    const std::string& getId() const;
+    TraderId getId() const;
 };
 
 } 
\ No newline at end of file
@@ -0,0 +1,164 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "../src/bounded_queue.hpp"
+#include "../src/event_logger.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace trading;
+
+TEST_CASE("BoundedQueue Methods", "[BoundedQueue]") {
+
+    SECTION("Capacity rounds up to a power of two") {
+        BoundedQueue<int> queue(5);
+        REQUIRE(queue.capacity() == 8);
+    }
+
+    SECTION("FIFO order and full/empty reporting") {
+        BoundedQueue<int> queue(4);
+        int value = 0;
+        REQUIRE_FALSE(queue.tryPop(value));
+
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(queue.tryPush(i));
+        }
+        REQUIRE_FALSE(queue.tryPush(99));
+
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(queue.tryPop(value));
+            REQUIRE(value == i);
+        }
+        REQUIRE_FALSE(queue.tryPop(value));
+
+        // Cells are reused on the next lap
+        REQUIRE(queue.tryPush(7));
+        REQUIRE(queue.tryPop(value));
+        REQUIRE(value == 7);
+    }
+
+    SECTION("Concurrent producer and consumer see every value once, in order") {
+        BoundedQueue<int> queue(64);
+        const int count = 100000;
+        std::thread producer([&] {
+            for (int i = 0; i < count; ++i) {
+                while (!queue.tryPush(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        int expected = 0;
+        bool ordered = true;
+        while (expected < count) {
+            int value;
+            if (queue.tryPop(value)) {
+                ordered = ordered && value == expected;
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        REQUIRE(ordered);
+    }
+}
+
+TEST_CASE("EventLogger Methods", "[EventLogger]") {
+
+    SECTION("Events are formatted by the writer thread") {
+        std::ostringstream out;
+        EventLogger logger(out);
+
+        LogEvent registered;
+        registered.type = EventType::TRADER_REGISTERED;
+        registered.traderId = 3;
+        logger.log(registered);
+
+        LogEvent trade;
+        trade.type = EventType::TRADE;
+        trade.orderId = 10;
+        trade.otherOrderId = 11;
+        trade.traderId = 1;
+        trade.otherTraderId = 2;
+        trade.price = 101.5;
+        trade.quantity = 4;
+        logger.log(trade);
+
+        logger.flush();
+        std::string text = out.str();
+        REQUIRE(text.find("TRADER REGISTERED: TRD-3\n") != std::string::npos);
+        REQUIRE(text.find("TRADE EXECUTED: 4.00 units at $101.50 | Buyer: TRD-1 (Order ORD-10)"
+                          " | Seller: TRD-2 (Order ORD-11)\n") != std::string::npos);
+        REQUIRE(text.find("TRADER REGISTERED") < text.find("TRADE EXECUTED"));
+    }
+
+    SECTION("The output stream's formatting state is left alone") {
+        std::ostringstream out;
+        out << std::scientific << std::setprecision(3);
+        {
+            EventLogger logger(out);
+            LogEvent trade;
+            trade.type = EventType::TRADE;
+            trade.price = 101.5;
+            trade.quantity = 4;
+            logger.log(trade);
+
+            LogEvent partial;
+            partial.type = EventType::PARTIAL;
+            partial.quantity = 1.5;
+            partial.remaining = 2.5;
+            logger.log(partial);
+        }
+
+        std::string text = out.str();
+        REQUIRE(text.find("4.00 units at $101.50") != std::string::npos);
+        REQUIRE(text.find(") 1.5 filled, 2.5 remaining\n") != std::string::npos);
+        REQUIRE((out.flags() & std::ios_base::floatfield) == std::ios_base::scientific);
+        REQUIRE(out.precision() == 3);
+    }
+
+    SECTION("A full ring makes the caller wait instead of dropping events") {
+        std::ostringstream out;
+        {
+            EventLogger logger(out, 2);
+            LogEvent event;
+            event.type = EventType::NO_MATCH;
+            event.isBuy = true;
+            for (int i = 0; i < 1000; ++i) {
+                event.orderId = static_cast<OrderId>(i);
+                logger.log(event);
+            }
+        }
+
+        // The destructor drains the ring
+        std::string text = out.str();
+        std::size_t lines = 0;
+        for (char c : text) {
+            lines += c == '\n';
+        }
+        REQUIRE(lines == 1000);
+        REQUIRE(text.find("ORDER STATUS: Buy order ORD-999 (Trader TRD-0) - No matching sell orders available")
+                != std::string::npos);
+    }
+
+    SECTION("Timestamps keep millisecond detail") {
+        std::string stamp = formatWallClock(1234567890123456789);
+        REQUIRE(stamp.size() == 23);
+        REQUIRE(stamp.substr(19) == ".123");
+    }
+
+    SECTION("Monotonic timestamps convert to wall clock") {
+        Timestamp first = monotonicNanos();
+        Timestamp second = monotonicNanos();
+        REQUIRE(second >= first);
+
+        std::int64_t wallNow = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        std::int64_t converted = toWallClockNanos(monotonicNanos());
+        REQUIRE(std::abs(converted - wallNow) < 1000000000);
+        REQUIRE(toWallClockNanos(second) - toWallClockNanos(first) == second - first);
+    }
+}
@@ -0,0 +1,75 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "../src/event_reporter.hpp"
+#include <sstream>
+
+using namespace trading;
+
+TEST_CASE("Event reporters", "[EventReporter]") {
+    LimitOrder buy(1, 100.0, 10, true);
+
+    Trade trade;
+    trade.buyOrderId = buy.getId();
+    trade.sellOrderId = 77;
+    trade.buyTraderId = 1;
+    trade.sellTraderId = 2;
+    trade.price = 100.0;
+    trade.quantity = 4;
+    trade.timestamp = monotonicNanos();
+    buy.setTimestamp(trade.timestamp + 1);
+
+    SECTION("TextReporter writes log lines") {
+        std::ostringstream out;
+        TextReporter reporter(out);
+        reporter.traderRegistered(5);
+        reporter.trade(trade);
+        reporter.partial(buy, 4);
+        reporter.flush();
+
+        std::string text = out.str();
+        REQUIRE(text.find("TRADER REGISTERED: TRD-5") != std::string::npos);
+        REQUIRE(text.find("TRADE EXECUTED: 4.00 units at $100.00") != std::string::npos);
+        REQUIRE(text.find("ORDER PARTIAL: Buy order " + formatOrderId(buy.getId()) +
+                          " (Trader TRD-1) 4 filled, 10 remaining") != std::string::npos);
+    }
+
+    SECTION("BinaryJournal round-trips raw records") {
+        std::stringstream journal;
+        {
+            BinaryJournal reporter(journal);
+            reporter.trade(trade);
+            reporter.rested(buy, 101.0);
+            reporter.complete(buy, 10);
+        }
+
+        std::vector<LogEvent> events = BinaryJournal::read(journal);
+        REQUIRE(events.size() == 3);
+        REQUIRE(events[0].type == EventType::TRADE);
+        REQUIRE(events[0].otherOrderId == 77);
+        REQUIRE(events[0].quantity == Qty(4));
+        REQUIRE(events[1].type == EventType::RESTED);
+        REQUIRE(events[1].price == Price(100.0));
+        REQUIRE(events[1].bestPrice == Price(101.0));
+        REQUIRE(events[2].type == EventType::COMPLETE);
+        REQUIRE(events[2].quantity == Qty(10));
+        REQUIRE(events[0].timestamp == trade.timestamp);
+        REQUIRE(events[1].timestamp == buy.getTimestamp());
+    }
+
+    SECTION("BinaryJournal writes whole blocks") {
+        std::stringstream journal;
+        BinaryJournal reporter(journal);
+        for (std::size_t i = 0; i < BinaryJournal::BLOCK_EVENTS; ++i) {
+            reporter.noMatch(buy);
+        }
+        REQUIRE(journal.str().size() == BinaryJournal::BLOCK_EVENTS * sizeof(LogEvent));
+    }
+
+    SECTION("NullReporter holds no state") {
+        NullReporter reporter;
+        reporter.trade(trade);
+        reporter.complete(buy, 10);
+        reporter.flush();
+        REQUIRE(std::is_empty_v<NullReporter>);
+    }
+}
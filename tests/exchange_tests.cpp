@@ -9,7 +9,7 @@
 using namespace trading;
 
 // Helper function to create a limit order
-std::shared_ptr<LimitOrder> createTestLimitOrder(const std::string& traderId,
+std::shared_ptr<LimitOrder> createTestLimitOrder(TraderId traderId,
                                                  double price,
                                                  double quantity,
                                                  bool isBuy)
@@ -18,7 +18,7 @@ std::shared_ptr<LimitOrder> createTestLimitOrder(const std::string& traderId,
 }
 
 // Helper function to create a market order
-std::shared_ptr<MarketOrder> createTestMarketOrder(const std::string& traderId,
+std::shared_ptr<MarketOrder> createTestMarketOrder(TraderId traderId,
                                                    double quantity,
                                                    bool isBuy)
 {
@@ -36,11 +36,12 @@ TEST_CASE("Exchange - Basic Functionality", "[Exchange]")
 
     SECTION("Register trader") {
         auto trader1 = exchange.registerTrader();
-        REQUIRE(trader1 -> getId() == "TRD-1");
+        REQUIRE(trader1 -> getId() == 1);
+        REQUIRE(formatTraderId(trader1 -> getId()) == "TRD-1");
 
         // Register another trader
         auto trader2 = exchange.registerTrader();
-        REQUIRE(trader2 -> getId() == "TRD-2");
+        REQUIRE(trader2 -> getId() == 2);
         REQUIRE(&trader2 != &trader1);
 
         // The exchange must store multiple traders
@@ -214,9 +215,37 @@ TEST_CASE("Exchange - Cancel & Modify Orders", "[Exchange]")
         REQUIRE(highestBid->getId() == buyOrder->getId());
     }
 
+    SECTION("Size decrease keeps queue priority; size increase loses it") {
+        auto first = trader1 -> createLimitOrder(100.0, 10.0, true);
+        auto second = trader1 -> createLimitOrder(100.0, 10.0, true);
+        exchange.submitOrder(first);
+        exchange.submitOrder(second);
+
+        // Shrink the first order: still at the front of the queue
+        REQUIRE(exchange.modifyOrder(first->getId(), 100.0, 4.0));
+        REQUIRE(first->getQuantity() == Approx(4.0));
+        REQUIRE(exchange.getOrderBook().getHighestBid()->getId() == first->getId());
+        REQUIRE(exchange.getOrderBook().getTopOfBook().bid.quantity == Approx(14.0));
+
+        // Unchanged modify is a no-op
+        REQUIRE(exchange.modifyOrder(first->getId(), 100.0, 4.0));
+        REQUIRE(exchange.getOrderBook().getHighestBid()->getId() == first->getId());
+
+        // Grow it: requeued behind the second order
+        REQUIRE(exchange.modifyOrder(first->getId(), 100.0, 6.0));
+        REQUIRE(exchange.getOrderBook().getHighestBid()->getId() == second->getId());
+
+        auto sell = trader2 -> createLimitOrder(100.0, 12.0, false);
+        auto fills = exchange.submitOrder(sell);
+        REQUIRE(fills.size() == 2);
+        REQUIRE(fills[0].buyOrderId == second->getId());
+        REQUIRE(fills[1].buyOrderId == first->getId());
+        REQUIRE(fills[1].quantity == Approx(2.0));
+    }
+
     SECTION("Modify non-existent order") {
         // Attempt to modify an order that doesn’t exist
-        bool mod = exchange.modifyOrder("no_such_id", 110.0, 10.0);
+        bool mod = exchange.modifyOrder(999999, 110.0, 10.0);
         REQUIRE_FALSE(mod);
     }
 
@@ -281,6 +310,13 @@ TEST_CASE("Exchange - Trade Records", "[Exchange]")
         // The exchange's master list of trades should also contain these two
         REQUIRE(exchange.getTrades().size() == 2);
 
+        // Trades from one submission share the order's acceptance time
+        REQUIRE(buyOrder->getTimestamp() > 0);
+        REQUIRE(tradeVec[0].timestamp == buyOrder->getTimestamp());
+        REQUIRE(tradeVec[1].timestamp == buyOrder->getTimestamp());
+        REQUIRE(sellOrder2->getTimestamp() >= sellOrder1->getTimestamp());
+        REQUIRE(buyOrder->getTimestamp() >= sellOrder2->getTimestamp());
+
         // The buy order still has leftover quantity (20 - 15 = 5), 
         // so it remains in the order book at price 55, the sell orders are fully filled
         REQUIRE_FALSE(exchange.getOrderBook().isEmpty());
@@ -288,4 +324,557 @@ TEST_CASE("Exchange - Trade Records", "[Exchange]")
         REQUIRE(leftoverBuy->getQuantity() == Approx(5.0));
         REQUIRE(leftoverBuy->getPrice() == Approx(55.0));
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Exchange - Trade Sinks", "[Exchange]")
+{
+    Exchange exchange;
+    auto maker = exchange.registerTrader();
+    auto taker = exchange.registerTrader();
+    exchange.submitOrder(maker->createLimitOrder(50.0, 10.0, false));
+    exchange.submitOrder(maker->createLimitOrder(51.0, 10.0, false));
+
+    SECTION("Trades stream into a reusable caller-owned buffer") {
+        std::vector<Trade> buffer;
+        buffer.reserve(8);
+        VectorTradeSink sink(buffer);
+
+        REQUIRE(exchange.submitOrder(taker->createLimitOrder(49.0, 5.0, true), sink) == 0);
+        REQUIRE(buffer.empty());
+
+        REQUIRE(exchange.submitOrder(taker->createLimitOrder(51.0, 15.0, true), sink) == 2);
+        REQUIRE(buffer.size() == 2);
+        REQUIRE(buffer[0].price == Approx(50.0));
+        REQUIRE(buffer[1].price == Approx(51.0));
+
+        // Clearing keeps the capacity for the next submission
+        const Trade* storage = buffer.data();
+        buffer.clear();
+        REQUIRE(exchange.submitOrder(taker->createMarketOrder(1.0, true), sink) == 1);
+        REQUIRE(buffer.data() == storage);
+
+        // The exchange's own record sees the same trades
+        REQUIRE(exchange.getTrades().size() == 3);
+    }
+
+    SECTION("Trades stream into a callback") {
+        Qty filled;
+        CallbackTradeSink sink([&filled](const Trade& trade) {
+            filled += trade.quantity;
+        });
+        REQUIRE(exchange.submitOrder(taker->createMarketOrder(12.0, true), sink) == 2);
+        REQUIRE(filled == Qty(12.0));
+    }
+}
+
+TEST_CASE("Exchange - Batch Submission", "[Exchange]")
+{
+    Exchange exchange;
+    auto maker = exchange.registerTrader();
+    auto taker = exchange.registerTrader();
+
+    std::vector<std::shared_ptr<Order>> batch = {
+        maker->createLimitOrder(50.0, 10.0, false),
+        maker->createLimitOrder(51.0, 10.0, false),
+        maker->createLimitOrder(48.0, 5.0, true),
+        taker->createLimitOrder(50.0, 4.0, true),
+        taker->createMarketOrder(8.0, true),
+    };
+
+    SECTION("Orders are matched in sequence, as if submitted one by one") {
+        auto fills = exchange.submitOrders(batch);
+        REQUIRE(fills.size() == 3);
+        REQUIRE(fills[0].price == Approx(50.0));
+        REQUIRE(fills[0].quantity == Approx(4.0));
+        REQUIRE(fills[1].price == Approx(50.0));
+        REQUIRE(fills[1].quantity == Approx(6.0));
+        REQUIRE(fills[2].price == Approx(51.0));
+        REQUIRE(fills[2].quantity == Approx(2.0));
+        REQUIRE(exchange.getTrades().size() == 3);
+
+        BookTop ask = exchange.getOrderBook().getTopOfBook().ask;
+        REQUIRE(ask.price == Approx(51.0));
+        REQUIRE(ask.quantity == Approx(8.0));
+    }
+
+    SECTION("Stats are updated once per batch") {
+        std::vector<Trade> buffer;
+        VectorTradeSink sink(buffer);
+        REQUIRE(exchange.submitOrders(batch, sink) == 3);
+
+        const ExchangeStats& stats = exchange.getStats();
+        REQUIRE(stats.ordersSubmitted == 5);
+        REQUIRE(stats.ordersRested == 3);
+        REQUIRE(stats.tradesExecuted == 3);
+        REQUIRE(stats.batchesSubmitted == 1);
+        REQUIRE(stats.volumeTraded == Approx(12.0));
+
+        // Single submissions count too
+        exchange.submitOrder(taker->createMarketOrder(1.0, true));
+        REQUIRE(stats.ordersSubmitted == 6);
+        REQUIRE(stats.batchesSubmitted == 1);
+        REQUIRE(stats.volumeTraded == Approx(13.0));
+    }
+}
+
+TEST_CASE("Exchange - Multiple Symbols", "[Exchange]")
+{
+    Exchange exchange(3);
+    auto maker = exchange.registerTrader();
+    auto taker = exchange.registerTrader();
+
+    SECTION("Each symbol has its own book") {
+        REQUIRE(exchange.getSymbolCount() == 3);
+        auto ask0 = maker->createLimitOrder(100.0, 5.0, false, 0);
+        auto ask2 = maker->createLimitOrder(200.0, 5.0, false, 2);
+        exchange.submitOrder(ask0);
+        exchange.submitOrder(ask2);
+
+        // A buy for symbol 1 finds nothing to match
+        auto trades = exchange.submitOrder(taker->createMarketOrder(3.0, true, 1));
+        REQUIRE(trades.empty());
+
+        trades = exchange.submitOrder(taker->createMarketOrder(3.0, true, 2));
+        REQUIRE(trades.size() == 1);
+        REQUIRE(trades[0].symbol == 2);
+        REQUIRE(trades[0].price == Approx(200.0));
+        REQUIRE(exchange.getTrades(2).size() == 1);
+        REQUIRE(exchange.getTrades(0).empty());
+        REQUIRE(exchange.getOrderBook(0).getTopOfBook().ask.quantity == Approx(5.0));
+        REQUIRE(exchange.getOrderBook(2).getTopOfBook().ask.quantity == Approx(2.0));
+        REQUIRE_THROWS_AS(exchange.getOrderBook(3), std::out_of_range);
+    }
+
+    SECTION("Cancel and modify look in the given symbol only") {
+        auto bid = maker->createLimitOrder(99.0, 4.0, true, 1);
+        exchange.submitOrder(bid);
+
+        REQUIRE_FALSE(exchange.cancelOrder(bid->getId()));
+        REQUIRE(maker->modifyOrder(1, bid->getId(), 99.0, 2.0));
+        REQUIRE(exchange.getOrderBook(1).getTopOfBook().bid.quantity == Approx(2.0));
+        REQUIRE(maker->cancelOrder(1, bid->getId()));
+        REQUIRE(exchange.getOrderBook(1).isEmpty());
+    }
+
+    SECTION("Orders for unlisted symbols are rejected") {
+        auto trades = exchange.submitOrder(maker->createLimitOrder(100.0, 5.0, false, 7));
+        REQUIRE(trades.empty());
+        REQUIRE(exchange.getStats().ordersRejected == 1);
+        REQUIRE(exchange.getStats().ordersSubmitted == 0);
+    }
+}
+
+TEST_CASE("Exchange - Parallel Batch Submission", "[Exchange]")
+{
+    // The same orders, matched per symbol in sequence and in parallel
+    const SymbolId symbolCount = 8;
+    Exchange sequential(symbolCount);
+    Exchange parallel(symbolCount);
+    auto build = [](Exchange& exchange) {
+        auto maker = exchange.registerTrader();
+        auto taker = exchange.registerTrader();
+        std::vector<std::shared_ptr<Order>> batch;
+        for (SymbolId symbol = 0; symbol < symbolCount; ++symbol) {
+            for (int i = 0; i < 20; ++i) {
+                batch.push_back(maker->createLimitOrder(100.0 + i % 5, 2.0, false, symbol));
+                batch.push_back(taker->createLimitOrder(100.0 + i % 3, 3.0, true, symbol));
+            }
+        }
+        batch.push_back(taker->createMarketOrder(1.0, true, symbolCount));
+        return batch;
+    };
+    auto sequentialBatch = build(sequential);
+    auto parallelBatch = build(parallel);
+
+    std::vector<Trade> fills;
+    VectorTradeSink sink(fills);
+    std::size_t sequentialTrades = sequential.submitOrders(sequentialBatch, sink);
+    std::size_t parallelTrades = parallel.submitOrdersParallel(parallelBatch, 3);
+    REQUIRE(parallelTrades == sequentialTrades);
+
+    for (SymbolId symbol = 0; symbol < symbolCount; ++symbol) {
+        const TradeStore& expected = sequential.getTrades(symbol);
+        const TradeStore& actual = parallel.getTrades(symbol);
+        REQUIRE(actual.size() == expected.size());
+        for (std::size_t i = 0; i < actual.size(); ++i) {
+            REQUIRE(actual[i].symbol == symbol);
+            REQUIRE(actual[i].price == expected[i].price);
+            REQUIRE(actual[i].quantity == expected[i].quantity);
+        }
+        REQUIRE(parallel.getOrderBook(symbol).getTopOfBook().bid.quantity
+                == sequential.getOrderBook(symbol).getTopOfBook().bid.quantity);
+    }
+
+    const ExchangeStats& stats = parallel.getStats();
+    REQUIRE(stats.ordersSubmitted == sequential.getStats().ordersSubmitted);
+    REQUIRE(stats.ordersRested == sequential.getStats().ordersRested);
+    REQUIRE(stats.ordersRejected == 1);
+    REQUIRE(stats.batchesSubmitted == 1);
+}
+
+TEST_CASE("Exchange - IOC and FOK Orders", "[Exchange]")
+{
+    Exchange exchange;
+    auto maker = exchange.registerTrader();
+    auto taker = exchange.registerTrader();
+    exchange.submitOrder(maker->createLimitOrder(100.0, 5.0, false));
+    exchange.submitOrder(maker->createLimitOrder(101.0, 5.0, false));
+    exchange.submitOrder(maker->createLimitOrder(103.0, 5.0, false));
+
+    SECTION("IOC fills what crosses and never rests") {
+        auto ioc = taker->createIocOrder(101.0, 12.0, true);
+        auto trades = exchange.submitOrder(ioc);
+        REQUIRE(trades.size() == 2);
+        REQUIRE(ioc->getQuantity() == Approx(2.0));
+        REQUIRE(exchange.getOrderBook().getTopOfBook().bid.orderCount == 0);
+        REQUIRE(exchange.getOrderBook().findOrder(ioc->getId()) == nullptr);
+        REQUIRE(exchange.getStats().ordersRested == 3);
+    }
+
+    SECTION("IOC that does not cross is cancelled") {
+        auto trades = exchange.submitOrder(taker->createIocOrder(99.0, 1.0, true));
+        REQUIRE(trades.empty());
+        REQUIRE(exchange.getOrderBook().getTopOfBook().bid.orderCount == 0);
+    }
+
+    SECTION("FOK fills in full when the crossing depth covers it") {
+        auto fok = taker->createFokOrder(103.0, 12.0, true);
+        auto trades = exchange.submitOrder(fok);
+        REQUIRE(trades.size() == 3);
+        REQUIRE(fok->getQuantity() == Qty());
+        REQUIRE(exchange.getOrderBook().getTopOfBook().ask.quantity == Approx(3.0));
+    }
+
+    SECTION("FOK is killed without touching the book") {
+        auto fok = taker->createFokOrder(101.0, 12.0, true);
+        auto trades = exchange.submitOrder(fok);
+        REQUIRE(trades.empty());
+        REQUIRE(fok->getQuantity() == Approx(12.0));
+        REQUIRE(exchange.getOrderBook().getDepth(false, 10) == Approx(15.0));
+        REQUIRE(exchange.getOrderBook().getTopOfBook().bid.orderCount == 0);
+    }
+}
+
+TEST_CASE("Exchange - Call Auction", "[Exchange]")
+{
+    Exchange exchange;
+    auto buyer = exchange.registerTrader();
+    auto seller = exchange.registerTrader();
+    exchange.openAuction();
+    REQUIRE(exchange.isAuctionOpen());
+
+    auto topBid = buyer->createLimitOrder(102.0, 5.0, true);
+    auto lowAsk = seller->createLimitOrder(99.0, 4.0, false);
+    REQUIRE(exchange.submitOrder(topBid).empty());
+    exchange.submitOrder(buyer->createLimitOrder(101.0, 5.0, true));
+    exchange.submitOrder(buyer->createLimitOrder(100.0, 12.0, true));
+    REQUIRE(exchange.submitOrder(lowAsk).empty());
+    exchange.submitOrder(seller->createLimitOrder(100.0, 6.0, false));
+    exchange.submitOrder(seller->createLimitOrder(101.0, 10.0, false));
+
+    // Collected orders rest crossed until the uncross
+    REQUIRE(exchange.getOrderBook().getTopOfBook().bid.price == Approx(102.0));
+    REQUIRE(exchange.getOrderBook().getTopOfBook().ask.price == Approx(99.0));
+
+    SECTION("Uncross trades everything at one price in priority order") {
+        auto trades = exchange.uncrossAuction();
+        Qty volume;
+        for (const auto& trade : trades) {
+            REQUIRE(trade.price == Approx(101.0));
+            volume += trade.quantity;
+        }
+        REQUIRE(volume == Approx(10.0));
+        REQUIRE(trades[0].buyOrderId == topBid->getId());
+        REQUIRE(trades[0].sellOrderId == lowAsk->getId());
+        REQUIRE(trades[0].quantity == Approx(4.0));
+
+        // The book is left uncrossed and the auction stays open
+        BookTop bid = exchange.getOrderBook().getTopOfBook().bid;
+        BookTop ask = exchange.getOrderBook().getTopOfBook().ask;
+        REQUIRE(bid.price == Approx(100.0));
+        REQUIRE(bid.quantity == Approx(12.0));
+        REQUIRE(ask.price == Approx(101.0));
+        REQUIRE(ask.quantity == Approx(10.0));
+        REQUIRE(exchange.isAuctionOpen());
+        REQUIRE(exchange.getStats().auctionsUncrossed == 1);
+        REQUIRE(exchange.getStats().volumeTraded == Approx(10.0));
+    }
+
+    SECTION("Market orders join the uncross and do not carry over") {
+        exchange.submitOrder(buyer->createMarketOrder(3.0, true));
+        auto huge = seller->createMarketOrder(500.0, false);
+        exchange.submitOrder(huge);
+        auto trades = exchange.uncrossAuction();
+        REQUIRE_FALSE(trades.empty());
+        REQUIRE(huge->getQuantity() > Qty());
+
+        // Nothing left to clear in the next interval
+        REQUIRE(exchange.uncrossAuction().empty());
+    }
+
+    SECTION("Immediate orders are rejected while the auction is open") {
+        exchange.submitOrder(buyer->createIocOrder(105.0, 1.0, true));
+        REQUIRE(exchange.getStats().ordersRejected == 1);
+    }
+
+    SECTION("Closing uncrosses and resumes continuous matching") {
+        exchange.closeAuction();
+        REQUIRE_FALSE(exchange.isAuctionOpen());
+        auto trades = exchange.submitOrder(buyer->createMarketOrder(2.0, true));
+        REQUIRE(trades.size() == 1);
+        REQUIRE(trades[0].price == Approx(101.0));
+    }
+
+    SECTION("The clearing price releases the stops it reaches") {
+        auto buyStop = buyer->createStopOrder(100.5, 1.0, true);
+        auto sellStop = seller->createStopOrder(99.0, 1.0, false);
+        exchange.submitOrder(buyStop);
+        exchange.submitOrder(sellStop);
+        REQUIRE(exchange.getStats().stopsHeld == 2);
+
+        // Uncrossing at 101 reaches the buy stop only; it waits for the next uncross
+        exchange.uncrossAuction();
+        REQUIRE(buyStop->isTriggered());
+        REQUIRE_FALSE(sellStop->isTriggered());
+        REQUIRE(buyStop->getQuantity() == Approx(1.0));
+
+        // Closing clears it against the ask at 101
+        auto trades = exchange.closeAuction();
+        REQUIRE(trades.size() == 1);
+        REQUIRE(trades[0].buyOrderId == buyStop->getId());
+        REQUIRE(trades[0].price == Approx(101.0));
+        REQUIRE(buyStop->getQuantity() == Qty());
+    }
+
+    SECTION("Stops released by the closing uncross match continuously") {
+        auto buyStop = buyer->createStopOrder(100.5, 1.0, true);
+        exchange.submitOrder(buyStop);
+        auto trades = exchange.closeAuction();
+        REQUIRE(trades.back().buyOrderId == buyStop->getId());
+        REQUIRE(trades.back().price == Approx(101.0));
+        REQUIRE(exchange.getOrderBook().getTopOfBook().ask.quantity == Approx(9.0));
+    }
+}
+
+TEST_CASE("Exchange - Stop Orders", "[Exchange]")
+{
+    Exchange exchange;
+    auto maker = exchange.registerTrader();
+    auto taker = exchange.registerTrader();
+    auto stopper = exchange.registerTrader();
+    exchange.submitOrder(maker->createLimitOrder(100.0, 2.0, false));
+    exchange.submitOrder(maker->createLimitOrder(102.0, 2.0, false));
+    exchange.submitOrder(maker->createLimitOrder(104.0, 5.0, false));
+    exchange.submitOrder(maker->createLimitOrder(98.0, 5.0, true));
+
+    SECTION("Stops are held until a trade reaches them") {
+        auto stop = stopper->createStopOrder(101.0, 1.0, true);
+        REQUIRE(exchange.submitOrder(stop).empty());
+        REQUIRE(exchange.getStats().stopsHeld == 1);
+        REQUIRE(exchange.getOrderBook().findOrder(stop->getId()) == nullptr);
+
+        // A trade at 100 does not reach 101
+        REQUIRE(exchange.submitOrder(taker->createMarketOrder(1.0, true)).size() == 1);
+        REQUIRE_FALSE(stop->isTriggered());
+
+        // Taking the rest at 100 and then 102 does; the stop buys at 102
+        auto trades = exchange.submitOrder(taker->createMarketOrder(2.0, true));
+        REQUIRE(trades.size() == 3);
+        REQUIRE(trades[2].buyOrderId == stop->getId());
+        REQUIRE(trades[2].price == Approx(102.0));
+        REQUIRE(stop->getQuantity() == Qty());
+    }
+
+    SECTION("Triggered stops can trigger further stops") {
+        auto first = stopper->createStopOrder(100.0, 4.0, true);
+        auto second = stopper->createStopLimitOrder(104.0, 104.0, 10.0, true);
+        exchange.submitOrder(first);
+        exchange.submitOrder(second);
+
+        // 100 reaches the first stop, which lifts 100, 102 and 104 and reaches the second
+        auto trades = exchange.submitOrder(taker->createMarketOrder(1.0, true));
+        REQUIRE(trades.size() == 5);
+        REQUIRE(trades[3].buyOrderId == first->getId());
+        REQUIRE(trades[4].buyOrderId == second->getId());
+        REQUIRE(second->getType() == OrderType::LIMIT);
+
+        // The stop-limit remainder rests at its limit price
+        BookTop bid = exchange.getOrderBook().getTopOfBook().bid;
+        REQUIRE(bid.price == Approx(104.0));
+        REQUIRE(bid.quantity == Approx(6.0));
+    }
+
+    SECTION("Sell stops trigger on falling prices and can be cancelled") {
+        auto stop = stopper->createStopOrder(99.0, 1.0, false);
+        auto cancelled = stopper->createStopOrder(98.0, 1.0, false);
+        exchange.submitOrder(stop);
+        exchange.submitOrder(cancelled);
+        REQUIRE(exchange.cancelOrder(cancelled->getId()));
+
+        auto trades = exchange.submitOrder(taker->createMarketOrder(1.0, false));
+        REQUIRE(trades.size() == 2);
+        REQUIRE(trades[1].sellOrderId == stop->getId());
+        REQUIRE_FALSE(cancelled->isTriggered());
+    }
+
+    SECTION("A stop already reached by the last trade runs at once") {
+        exchange.submitOrder(taker->createMarketOrder(1.0, true));
+        auto trades = exchange.submitOrder(stopper->createStopOrder(99.0, 1.0, true));
+        REQUIRE(trades.size() == 1);
+        REQUIRE(exchange.getStats().stopsHeld == 0);
+    }
+}
+
+TEST_CASE("Exchange - Iceberg Orders", "[Exchange]")
+{
+    Exchange exchange;
+    auto maker = exchange.registerTrader();
+    auto taker = exchange.registerTrader();
+
+    SECTION("An incoming iceberg trades its full size before resting") {
+        exchange.submitOrder(taker->createLimitOrder(100.0, 30.0, true));
+        auto iceberg = maker->createIcebergOrder(100.0, 50.0, 5.0, false);
+        auto trades = exchange.submitOrder(iceberg);
+        REQUIRE(trades.size() == 1);
+        REQUIRE(trades[0].quantity == Approx(30.0));
+        REQUIRE(iceberg->getQuantity() == Approx(5.0));
+        REQUIRE(iceberg->getHiddenQuantity() == Approx(15.0));
+        REQUIRE(exchange.getOrderBook().getTopOfBook().ask.quantity == Approx(5.0));
+    }
+
+    SECTION("A large taker sweeps through every slice") {
+        auto iceberg = maker->createIcebergOrder(100.0, 20.0, 5.0, false);
+        exchange.submitOrder(iceberg);
+        auto trades = exchange.submitOrder(taker->createMarketOrder(18.0, true));
+        REQUIRE(trades.size() == 4);
+        for (const auto& trade : trades) {
+            REQUIRE(trade.sellOrderId == iceberg->getId());
+        }
+        REQUIRE(iceberg->getQuantity() == Approx(2.0));
+        REQUIRE(iceberg->getHiddenQuantity() == Qty());
+
+        REQUIRE(exchange.cancelOrder(iceberg->getId()));
+        REQUIRE(exchange.getOrderBook().isEmpty());
+    }
+
+    SECTION("Fill-or-kill counts the hidden reserve") {
+        auto iceberg = maker->createIcebergOrder(100.0, 50.0, 5.0, false);
+        exchange.submitOrder(iceberg);
+        auto fok = taker->createFokOrder(100.0, 20.0, true);
+        auto trades = exchange.submitOrder(fok);
+        REQUIRE(trades.size() == 4);
+        REQUIRE(fok->getQuantity() == Qty());
+        REQUIRE(iceberg->getTotalQuantity() == Approx(30.0));
+
+        // More than the whole iceberg is still killed
+        REQUIRE(exchange.submitOrder(taker->createFokOrder(100.0, 31.0, true)).empty());
+        REQUIRE(iceberg->getTotalQuantity() == Approx(30.0));
+    }
+
+    SECTION("Amends apply to the total size, never creating quantity") {
+        auto iceberg = maker->createIcebergOrder(100.0, 50.0, 5.0, false);
+        exchange.submitOrder(iceberg);
+
+        // The current total is a no-op; larger totals requeue with a bigger reserve
+        REQUIRE(exchange.modifyOrder(iceberg->getId(), 100.0, 50.0));
+        REQUIRE(iceberg->getTotalQuantity() == Approx(50.0));
+        REQUIRE(exchange.modifyOrder(iceberg->getId(), 100.0, 60.0));
+        REQUIRE(iceberg->getQuantity() == Approx(5.0));
+        REQUIRE(iceberg->getTotalQuantity() == Approx(60.0));
+
+        // Smaller totals come out of the reserve, then the visible slice
+        REQUIRE(exchange.modifyOrder(iceberg->getId(), 100.0, 20.0));
+        REQUIRE(iceberg->getQuantity() == Approx(5.0));
+        REQUIRE(iceberg->getTotalQuantity() == Approx(20.0));
+        REQUIRE(exchange.modifyOrder(iceberg->getId(), 100.0, 2.0));
+        REQUIRE(iceberg->getQuantity() == Approx(2.0));
+        REQUIRE(iceberg->getTotalQuantity() == Approx(2.0));
+
+        // A price change keeps the total
+        REQUIRE(exchange.modifyOrder(iceberg->getId(), 101.0, 30.0));
+        REQUIRE(iceberg->getTotalQuantity() == Approx(30.0));
+        auto trades = exchange.submitOrder(taker->createMarketOrder(100.0, true));
+        Qty volume;
+        for (const auto& trade : trades) {
+            volume += trade.quantity;
+        }
+        REQUIRE(volume == Approx(30.0));
+    }
+}
+
+TEST_CASE("Exchange - Self-Trade Prevention", "[Exchange]")
+{
+    Exchange exchange;
+    auto maker = exchange.registerTrader();
+    auto other = exchange.registerTrader();
+    REQUIRE(exchange.getSelfTradePrevention() == SelfTradePrevention::NONE);
+
+    auto staleAsk = maker->createLimitOrder(100.0, 5.0, false);
+    exchange.submitOrder(staleAsk);
+    exchange.submitOrder(other->createLimitOrder(101.0, 5.0, false));
+
+    SECTION("Cancel oldest lets a requote replace the stale order") {
+        exchange.setSelfTradePrevention(SelfTradePrevention::CANCEL_OLDEST);
+        auto trades = exchange.submitOrder(maker->createLimitOrder(100.5, 3.0, true));
+        REQUIRE(trades.empty());
+        REQUIRE(exchange.getOrderBook().findOrder(staleAsk->getId()) == nullptr);
+        REQUIRE(exchange.getOrderBook().getTopOfBook().bid.price == Approx(100.5));
+        REQUIRE(exchange.getStats().tradesExecuted == 0);
+    }
+
+    SECTION("Cancel newest drops the incoming order without resting it") {
+        exchange.setSelfTradePrevention(SelfTradePrevention::CANCEL_NEWEST);
+        auto trades = exchange.submitOrder(maker->createLimitOrder(101.0, 8.0, true));
+        REQUIRE(trades.empty());
+        REQUIRE(exchange.getOrderBook().getTopOfBook().bid.orderCount == 0);
+        REQUIRE(exchange.getOrderBook().getTopOfBook().ask.quantity == Approx(5.0));
+        REQUIRE(exchange.getStats().volumeTraded == Qty());
+    }
+
+    SECTION("Decrement both trades only with other traders") {
+        exchange.setSelfTradePrevention(SelfTradePrevention::DECREMENT_BOTH);
+        auto trades = exchange.submitOrder(maker->createMarketOrder(8.0, true));
+        REQUIRE(trades.size() == 1);
+        REQUIRE(trades[0].sellTraderId == other->getId());
+        REQUIRE(trades[0].quantity == Approx(3.0));
+        REQUIRE(exchange.getStats().volumeTraded == Approx(3.0));
+    }
+
+    SECTION("Fill-or-kill without prevention counts the trader's own orders") {
+        auto trades = exchange.submitOrder(maker->createFokOrder(101.0, 8.0, true));
+        REQUIRE(trades.size() == 2);
+        REQUIRE(exchange.getStats().volumeTraded == Approx(8.0));
+    }
+
+    SECTION("Fill-or-kill with cancel newest only counts what is ahead of an own order") {
+        exchange.setSelfTradePrevention(SelfTradePrevention::CANCEL_NEWEST);
+        auto fok = maker->createFokOrder(101.0, 3.0, true);
+        REQUIRE(exchange.submitOrder(fok).empty());
+        REQUIRE(fok->getQuantity() == Approx(3.0));
+        REQUIRE(exchange.getOrderBook().findOrder(staleAsk->getId()) != nullptr);
+
+        // Another trader's order ahead of the own order can still fill it
+        exchange.submitOrder(other->createLimitOrder(99.5, 2.0, false));
+        REQUIRE(exchange.submitOrder(maker->createFokOrder(101.0, 2.0, true)).size() == 1);
+        REQUIRE(exchange.submitOrder(maker->createFokOrder(101.0, 1.0, true)).empty());
+    }
+
+    SECTION("Fill-or-kill with cancel oldest counts other traders only") {
+        exchange.setSelfTradePrevention(SelfTradePrevention::CANCEL_OLDEST);
+        REQUIRE(exchange.submitOrder(maker->createFokOrder(101.0, 6.0, true)).empty());
+        REQUIRE(exchange.getOrderBook().findOrder(staleAsk->getId()) != nullptr);
+
+        auto trades = exchange.submitOrder(maker->createFokOrder(101.0, 5.0, true));
+        REQUIRE(trades.size() == 1);
+        REQUIRE(trades[0].sellTraderId == other->getId());
+        REQUIRE(exchange.getOrderBook().findOrder(staleAsk->getId()) == nullptr);
+    }
+
+    SECTION("Fill-or-kill with decrement both is killed by an own order in the way") {
+        exchange.setSelfTradePrevention(SelfTradePrevention::DECREMENT_BOTH);
+        auto fok = maker->createFokOrder(101.0, 8.0, true);
+        REQUIRE(exchange.submitOrder(fok).empty());
+        REQUIRE(fok->getQuantity() == Approx(8.0));
+        REQUIRE(staleAsk->getQuantity() == Approx(5.0));
+        REQUIRE(exchange.getStats().volumeTraded == Qty());
+    }
+}
@@ -0,0 +1,102 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "../src/exchange.hpp"
+#include "../src/matching_engine.hpp"
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace trading;
+
+TEST_CASE("MatchingEngine Commands", "[MatchingEngine]") {
+    Exchange exchange;
+    auto maker = exchange.registerTrader();
+    auto taker = exchange.registerTrader();
+    MatchingEngine engine(exchange, 64);
+
+    auto ask = maker->createLimitOrder(100.0, 5.0, false);
+    std::uint64_t first = engine.submit(ask);
+    std::uint64_t second = engine.submit(taker->createMarketOrder(2.0, true));
+    std::uint64_t third = engine.modify(0, ask->getId(), 100.0, 1.0);
+    std::uint64_t fourth = engine.cancel(0, 999999);
+    engine.waitIdle();
+
+    SECTION("Results come back in order with their outcome") {
+        CommandResult result;
+        REQUIRE(engine.pollResult(result));
+        REQUIRE(result.sequence == first);
+        REQUIRE(result.type == CommandType::NEW);
+        REQUIRE(result.orderId == ask->getId());
+        REQUIRE(result.accepted);
+        REQUIRE(result.trades == 0);
+
+        REQUIRE(engine.pollResult(result));
+        REQUIRE(result.sequence == second);
+        REQUIRE(result.trades == 1);
+
+        REQUIRE(engine.pollResult(result));
+        REQUIRE(result.sequence == third);
+        REQUIRE(result.type == CommandType::MODIFY);
+        REQUIRE(result.accepted);
+
+        REQUIRE(engine.pollResult(result));
+        REQUIRE(result.sequence == fourth);
+        REQUIRE(result.type == CommandType::CANCEL);
+        REQUIRE_FALSE(result.accepted);
+
+        REQUIRE_FALSE(engine.pollResult(result));
+    }
+
+    SECTION("Trades are published and the book is updated") {
+        Trade trade;
+        REQUIRE(engine.pollTrade(trade));
+        REQUIRE(trade.sellOrderId == ask->getId());
+        REQUIRE(trade.price == Approx(100.0));
+        REQUIRE(trade.quantity == Approx(2.0));
+        REQUIRE_FALSE(engine.pollTrade(trade));
+
+        REQUIRE(exchange.getOrderBook().getTopOfBook().ask.quantity == Approx(1.0));
+    }
+}
+
+TEST_CASE("MatchingEngine with several producers", "[MatchingEngine]") {
+    const int producers = 4;
+    const int ordersEach = 250;
+    Exchange exchange;
+    std::vector<std::shared_ptr<Trader>> traders;
+    for (int i = 0; i < producers + 1; ++i) {
+        traders.push_back(exchange.registerTrader());
+    }
+
+    {
+        MatchingEngine engine(exchange, 2048);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < producers; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < ordersEach; ++i) {
+                    engine.submit(traders[t]->createLimitOrder(100.0 + t, 1.0, false));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        engine.waitIdle();
+
+        // Every command got exactly one result with its own sequence number
+        std::set<std::uint64_t> sequences;
+        CommandResult result;
+        while (engine.pollResult(result)) {
+            REQUIRE(result.accepted);
+            sequences.insert(result.sequence);
+        }
+        REQUIRE(sequences.size() == producers * ordersEach);
+        REQUIRE(exchange.getOrderBook().getDepth(false, 10) == Approx(producers * ordersEach));
+
+        // Posted but not waited for: the destructor still applies it
+        engine.submit(traders[producers]->createMarketOrder(producers * ordersEach, true));
+    }
+
+    REQUIRE(exchange.getOrderBook().getTopOfBook().ask.orderCount == 0);
+    REQUIRE(exchange.getTrades().size() == producers * ordersEach);
+}
@@ -2,11 +2,13 @@
 #include "catch.hpp"
 #include "../src/order_book.hpp"
 #include "../src/order.hpp"
+#include <array>
+#include <vector>
 
 using namespace trading;
 
 // Helper function to create a limit order
-std::shared_ptr<LimitOrder> createLimitOrderTest(const std::string& traderId, double price, double quantity, bool isBuy) {
+std::shared_ptr<LimitOrder> createLimitOrderTest(TraderId traderId, double price, double quantity, bool isBuy) {
     return std::make_shared<LimitOrder>(traderId, price, quantity, isBuy);
 }
 
@@ -20,8 +22,8 @@ TEST_CASE("PriceLevel Methods", "[PriceLevel]") {
     
     SECTION("Add orders") {
         PriceLevel level(100.0);
-        auto order1 = createLimitOrderTest("trader1", 99.0, 10.0, true);
-        auto order2 = createLimitOrderTest("trader2", 101.0, 20.0, false);
+        auto order1 = createLimitOrderTest(1, 99.0, 10.0, true);
+        auto order2 = createLimitOrderTest(2, 101.0, 20.0, false);
         
         level.addOrder(order1);
         REQUIRE(level.orders.size() == 1);
@@ -32,8 +34,8 @@ TEST_CASE("PriceLevel Methods", "[PriceLevel]") {
     
     SECTION("Remove orders") {
         PriceLevel level(100.0);
-        auto order1 = createLimitOrderTest("trader1", 100.0, 10.0, true);
-        auto order2 = createLimitOrderTest("trader2", 100.0, 20.0, true);
+        auto order1 = createLimitOrderTest(1, 100.0, 10.0, true);
+        auto order2 = createLimitOrderTest(2, 100.0, 20.0, true);
         
         level.addOrder(order1);
         level.addOrder(order2);
@@ -44,15 +46,15 @@ TEST_CASE("PriceLevel Methods", "[PriceLevel]") {
         REQUIRE(level.orders.size() == 1);
         
         // Remove non-existing order
-        bool removedOrder = level.removeOrder("12345");
+        bool removedOrder = level.removeOrder(999999);
         REQUIRE_FALSE(removedOrder);
         REQUIRE(level.orders.size() == 1);
     }
     
     SECTION("Find orders") {
         PriceLevel level(100.0);
-        auto order1 = createLimitOrderTest("trader1", 100.0, 10.0, true);
-        auto order2 = createLimitOrderTest("trader2", 100.0, 20.0, true);
+        auto order1 = createLimitOrderTest(1, 100.0, 10.0, true);
+        auto order2 = createLimitOrderTest(2, 100.0, 20.0, true);
         
         level.addOrder(order1);
         level.addOrder(order2);
@@ -63,7 +65,7 @@ TEST_CASE("PriceLevel Methods", "[PriceLevel]") {
         REQUIRE(foundOrder->getId() == order1->getId());
         
         // Find non-existing order
-        auto notFoundOrder = level.findOrder("12345");
+        auto notFoundOrder = level.findOrder(999999);
         REQUIRE(notFoundOrder == nullptr);
     }
 }
@@ -80,15 +82,15 @@ TEST_CASE("OrderBook Methods", "[OrderBook]") {
         OrderBook book;
         
         // Add buy orders
-        auto buyOrder1 = createLimitOrderTest("trader1", 98.0, 10.0, true);
-        auto buyOrder2 = createLimitOrderTest("trader1", 99.0, 20.0, true);
+        auto buyOrder1 = createLimitOrderTest(1, 98.0, 10.0, true);
+        auto buyOrder2 = createLimitOrderTest(1, 99.0, 20.0, true);
         
         book.addOrder(buyOrder1);
         book.addOrder(buyOrder2);
         
         // Add sell orders
-        auto sellOrder1 = createLimitOrderTest("trader2", 101.0, 15.0, false);
-        auto sellOrder2 = createLimitOrderTest("trader2", 102.0, 25.0, false);
+        auto sellOrder1 = createLimitOrderTest(2, 101.0, 15.0, false);
+        auto sellOrder2 = createLimitOrderTest(2, 102.0, 25.0, false);
         
         book.addOrder(sellOrder1);
         book.addOrder(sellOrder2);
@@ -104,8 +106,8 @@ TEST_CASE("OrderBook Methods", "[OrderBook]") {
     SECTION("Find orders") {
         OrderBook book;
         
-        auto buyOrder = createLimitOrderTest("trader1", 99.0, 10.0, true);
-        auto sellOrder = createLimitOrderTest("trader2", 101.0, 15.0, false);
+        auto buyOrder = createLimitOrderTest(1, 99.0, 10.0, true);
+        auto sellOrder = createLimitOrderTest(2, 101.0, 15.0, false);
         
         book.addOrder(buyOrder);
         book.addOrder(sellOrder);
@@ -120,15 +122,15 @@ TEST_CASE("OrderBook Methods", "[OrderBook]") {
         REQUIRE(foundSellOrder->getId() == sellOrder->getId());
         
         // Find non-existing order
-        auto notFoundOrder = book.findOrder("12345");
+        auto notFoundOrder = book.findOrder(999999);
         REQUIRE(notFoundOrder == nullptr);
     }
     
     SECTION("Remove orders") {
         OrderBook book;
         
-        auto buyOrder = createLimitOrderTest("trader1", 99.0, 10.0, true);
-        auto sellOrder = createLimitOrderTest("trader2", 101.0, 15.0, false);
+        auto buyOrder = createLimitOrderTest(1, 99.0, 10.0, true);
+        auto sellOrder = createLimitOrderTest(2, 101.0, 15.0, false);
         
         book.addOrder(buyOrder);
         book.addOrder(sellOrder);
@@ -150,7 +152,7 @@ TEST_CASE("OrderBook Methods", "[OrderBook]") {
         REQUIRE(book.isEmpty());
         
         // Remove non-existing order
-        bool removedOrder = book.removeOrder("12345");
+        bool removedOrder = book.removeOrder(999999);
         REQUIRE_FALSE(removedOrder);
     }
     
@@ -158,8 +160,8 @@ TEST_CASE("OrderBook Methods", "[OrderBook]") {
         OrderBook book;
         
         // Add multiple buy orders at the same price levels
-        auto buyOrder1 = createLimitOrderTest("trader1", 100.0, 10.0, true);
-        auto buyOrder2 = createLimitOrderTest("trader1", 100.0, 20.0, true);
+        auto buyOrder1 = createLimitOrderTest(1, 100.0, 10.0, true);
+        auto buyOrder2 = createLimitOrderTest(1, 100.0, 20.0, true);
         
         book.addOrder(buyOrder1);
         book.addOrder(buyOrder2);
@@ -174,11 +176,53 @@ TEST_CASE("OrderBook Methods", "[OrderBook]") {
         REQUIRE(book.getHighestBid()->getId() == buyOrder2->getId());
     }
     
+    SECTION("Cancel from the middle of a deep level") {
+        OrderBook book;
+        std::vector<std::shared_ptr<LimitOrder>> orders;
+        for (int i = 0; i < 100; ++i) {
+            orders.push_back(createLimitOrderTest(1, 100.0, 1.0 + i, false));
+            book.addOrder(orders.back());
+        }
+
+        // Remove an order deep inside the queue
+        REQUIRE(book.removeOrder(orders[50]->getId()));
+        REQUIRE(book.findOrder(orders[50]->getId()) == nullptr);
+        REQUIRE(book.findOrder(orders[51]->getId())->getQuantity() == 52.0);
+
+        // Time priority is unaffected
+        REQUIRE(book.getLowestAsk()->getId() == orders[0]->getId());
+        REQUIRE(book.removeOrder(orders[0]->getId()));
+        REQUIRE(book.getLowestAsk()->getId() == orders[1]->getId());
+    }
+    
+    SECTION("Best price tracking across sparse levels") {
+        OrderBook book;
+        auto ask1 = createLimitOrderTest(2, 101.0, 1.0, false);
+        auto ask2 = createLimitOrderTest(2, 150.0, 1.0, false);
+        auto ask3 = createLimitOrderTest(2, 90.0, 1.0, false);
+        book.addOrder(ask1);
+        book.addOrder(ask2);
+        book.addOrder(ask3);
+        REQUIRE(book.getLowestAsk()->getPrice() == 90.0);
+
+        book.removeOrder(ask3->getId());
+        REQUIRE(book.getLowestAsk()->getPrice() == 101.0);
+        book.removeOrder(ask1->getId());
+        REQUIRE(book.getLowestAsk()->getPrice() == 150.0);
+        book.removeOrder(ask2->getId());
+        REQUIRE(book.getLowestAsk() == nullptr);
+
+        // Side empties and moves to a far away price
+        auto ask4 = createLimitOrderTest(2, 2000.0, 1.0, false);
+        book.addOrder(ask4);
+        REQUIRE(book.getLowestAsk()->getId() == ask4->getId());
+    }
+    
     SECTION("Select best bid/ask price") {
         OrderBook book;
 
-        auto buyOrder1 = createLimitOrderTest("trader1", 100.0, 10.0, true);
-        auto buyOrder2 = createLimitOrderTest("trader1", 101.0, 20.0, true); 
+        auto buyOrder1 = createLimitOrderTest(1, 100.0, 10.0, true);
+        auto buyOrder2 = createLimitOrderTest(1, 101.0, 20.0, true); 
         
         book.addOrder(buyOrder1);
         book.addOrder(buyOrder2);
@@ -186,8 +230,8 @@ TEST_CASE("OrderBook Methods", "[OrderBook]") {
         // Check highest bid
         REQUIRE(book.getHighestBid()->getPrice() == 101.0);
         
-        auto sellOrder1 = createLimitOrderTest("trader2", 103.0, 15.0, false);
-        auto sellOrder2 = createLimitOrderTest("trader2", 102.0, 25.0, false); 
+        auto sellOrder1 = createLimitOrderTest(2, 103.0, 15.0, false);
+        auto sellOrder2 = createLimitOrderTest(2, 102.0, 25.0, false); 
         
         book.addOrder(sellOrder1);
         book.addOrder(sellOrder2);
@@ -195,4 +239,473 @@ TEST_CASE("OrderBook Methods", "[OrderBook]") {
         // Check lowest ask
         REQUIRE(book.getLowestAsk()->getPrice() == 102.0);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("OrderBook top of book cache", "[OrderBook]") {
+    OrderBook book;
+
+    SECTION("Empty book") {
+        TopOfBook top = book.getTopOfBook();
+        REQUIRE(top.bid.orderCount == 0);
+        REQUIRE(top.ask.orderCount == 0);
+    }
+
+    SECTION("Adds aggregate at the best price") {
+        book.addOrder(createLimitOrderTest(1, 99.0, 10.0, true));
+        book.addOrder(createLimitOrderTest(1, 99.0, 5.0, true));
+        book.addOrder(createLimitOrderTest(1, 98.0, 7.0, true));
+
+        TopOfBook top = book.getTopOfBook();
+        REQUIRE(top.bid.price == 99.0);
+        REQUIRE(top.bid.quantity == 15.0);
+        REQUIRE(top.bid.orderCount == 2);
+
+        // A better price replaces the cached top
+        book.addOrder(createLimitOrderTest(1, 100.0, 1.0, true));
+        top = book.getTopOfBook();
+        REQUIRE(top.bid.price == 100.0);
+        REQUIRE(top.bid.quantity == 1.0);
+        REQUIRE(top.bid.orderCount == 1);
+    }
+
+    SECTION("Removes and fills update the cache") {
+        auto ask1 = createLimitOrderTest(2, 101.0, 10.0, false);
+        auto ask2 = createLimitOrderTest(2, 101.0, 20.0, false);
+        auto ask3 = createLimitOrderTest(2, 102.0, 30.0, false);
+        book.addOrder(ask1);
+        book.addOrder(ask2);
+        book.addOrder(ask3);
+
+        REQUIRE(book.fillOrder(ask1->getId(), 4.0));
+        REQUIRE(book.getTopOfBook().ask.quantity == 26.0);
+        REQUIRE(book.findOrder(ask1->getId())->getQuantity() == 6.0);
+
+        // Full fill removes the order
+        REQUIRE(book.fillOrder(ask1->getId(), 6.0));
+        REQUIRE(book.findOrder(ask1->getId()) == nullptr);
+        REQUIRE(book.getTopOfBook().ask.quantity == 20.0);
+        REQUIRE(book.getTopOfBook().ask.orderCount == 1);
+
+        // Emptying the best level moves the cache to the next level
+        REQUIRE(book.removeOrder(ask2->getId()));
+        TopOfBook top = book.getTopOfBook();
+        REQUIRE(top.ask.price == 102.0);
+        REQUIRE(top.ask.quantity == 30.0);
+        REQUIRE(top.ask.orderCount == 1);
+
+        REQUIRE(book.removeOrder(ask3->getId()));
+        REQUIRE(book.getTopOfBook().ask.orderCount == 0);
+        REQUIRE_FALSE(book.fillOrder(ask3->getId(), 1.0));
+    }
+}
+
+TEST_CASE("Level aggregates and depth queries", "[OrderBook]") {
+
+    SECTION("PriceLevel running totals") {
+        PriceLevel level(100.0);
+        auto order1 = createLimitOrderTest(1, 100.0, 10.0, true);
+        auto order2 = createLimitOrderTest(1, 100.0, 20.0, true);
+        auto position1 = level.addOrder(order1);
+        level.addOrder(order2);
+        REQUIRE(level.totalQuantity == 30.0);
+        REQUIRE(level.orderCount == 2);
+
+        level.reduceOrder(position1, 4.0);
+        REQUIRE(order1->getQuantity() == 6.0);
+        REQUIRE(level.totalQuantity == 26.0);
+
+        level.removeOrder(order2->getId());
+        REQUIRE(level.totalQuantity == 6.0);
+        REQUIRE(level.orderCount == 1);
+    }
+
+    SECTION("Depth, imbalance and sweep cost") {
+        OrderBook book;
+        book.addOrder(createLimitOrderTest(1, 99.0, 10.0, true));
+        book.addOrder(createLimitOrderTest(1, 98.0, 30.0, true));
+        auto ask1 = createLimitOrderTest(2, 101.0, 5.0, false);
+        book.addOrder(ask1);
+        book.addOrder(createLimitOrderTest(2, 101.0, 5.0, false));
+        book.addOrder(createLimitOrderTest(2, 103.0, 20.0, false));
+
+        REQUIRE(book.getDepth(true, 1) == 10.0);
+        REQUIRE(book.getDepth(true, 5) == 40.0);
+        REQUIRE(book.getDepth(false, 1) == 10.0);
+        REQUIRE(book.getDepth(false, 0) == 0.0);
+        REQUIRE(book.getImbalance(5) == Approx((40.0 - 30.0) / 70.0));
+
+        // Buying 15 takes 10 @ 101 and 5 @ 103
+        SweepCost cost = book.getSweepCost(true, 15.0);
+        REQUIRE(cost.quantity == 15.0);
+        REQUIRE(cost.notional == Approx(10 * 101.0 + 5 * 103.0));
+
+        // Asking for more than the side holds stops at the available depth
+        cost = book.getSweepCost(false, 100.0);
+        REQUIRE(cost.quantity == 40.0);
+
+        // Crossing depth stops at the limit price and at the requested quantity
+        REQUIRE(book.getCrossingDepth(true, 102.0, 100.0) == 10.0);
+        REQUIRE(book.getCrossingDepth(true, 103.0, 25.0) == 25.0);
+        REQUIRE(book.getCrossingDepth(true, 100.0, 5.0) == 0.0);
+        REQUIRE(book.getCrossingDepth(false, 98.0, 100.0) == 40.0);
+
+        // Fills keep level totals exact
+        book.fillOrder(ask1->getId(), 2.0);
+        REQUIRE(book.getDepth(false, 1) == 8.0);
+    }
+}
+
+TEST_CASE("Depth snapshots", "[OrderBook]") {
+    OrderBook book;
+    book.addOrder(createLimitOrderTest(1, 99.0, 10.0, true));
+    book.addOrder(createLimitOrderTest(1, 99.0, 5.0, true));
+    book.addOrder(createLimitOrderTest(1, 97.0, 30.0, true));
+    book.addOrder(createLimitOrderTest(2, 101.0, 7.0, false));
+
+    SECTION("Top levels in priority order") {
+        std::array<LevelView, 4> buffer{};
+        std::size_t count = book.snapshotDepth(true, 4, buffer);
+        REQUIRE(count == 2);
+        REQUIRE(buffer[0].price == 99.0);
+        REQUIRE(buffer[0].quantity == 15.0);
+        REQUIRE(buffer[0].orderCount == 2);
+        REQUIRE(buffer[1].price == 97.0);
+        REQUIRE(buffer[1].quantity == 30.0);
+
+        count = book.snapshotDepth(false, 4, buffer);
+        REQUIRE(count == 1);
+        REQUIRE(buffer[0].price == 101.0);
+    }
+
+    SECTION("Bounded by N and by the buffer size") {
+        std::array<LevelView, 4> buffer{};
+        REQUIRE(book.snapshotDepth(true, 1, buffer) == 1);
+        REQUIRE(book.snapshotDepth(true, 4, std::span<LevelView>(buffer.data(), 1)) == 1);
+        REQUIRE(book.snapshotDepth(true, 0, buffer) == 0);
+    }
+}
+
+TEST_CASE("Status codes and diagnostics", "[OrderBook]") {
+    OrderBook book;
+
+    SECTION("Routine failures return a status and bump a counter") {
+        REQUIRE(book.tryRemoveOrder(999999) == BookStatus::NOT_FOUND);
+        REQUIRE(book.tryFindOrder(999999).status == BookStatus::NOT_FOUND);
+        REQUIRE_FALSE(book.tryBestBid());
+        REQUIRE(book.tryBestAsk().status == BookStatus::EMPTY_SIDE);
+
+        const BookDiagnostics& diagnostics = book.getDiagnostics();
+        REQUIRE(diagnostics.notFound == 2);
+        REQUIRE(diagnostics.emptySide == 2);
+    }
+
+    SECTION("Invalid and duplicate orders are rejected") {
+        auto order = createLimitOrderTest(1, 100.0, 10.0, true);
+        REQUIRE(book.addOrder(order) == BookStatus::OK);
+        REQUIRE(book.addOrder(order) == BookStatus::INVALID_ORDER);
+        REQUIRE(book.addOrder(nullptr) == BookStatus::INVALID_ORDER);
+        REQUIRE(book.addOrder(std::make_shared<MarketOrder>(1, 10.0, true)) == BookStatus::INVALID_ORDER);
+        REQUIRE(book.getDiagnostics().invalidOrders == 3);
+        REQUIRE(book.getTopOfBook().bid.orderCount == 1);
+    }
+
+    SECTION("Successful lookups return non-owning pointers") {
+        auto order = createLimitOrderTest(1, 100.0, 10.0, false);
+        book.addOrder(order);
+        auto found = book.tryFindOrder(order->getId());
+        REQUIRE(found);
+        REQUIRE(found.value == order.get());
+        REQUIRE(book.tryBestAsk().value == order.get());
+        REQUIRE(book.tryRemoveOrder(order->getId()) == BookStatus::OK);
+    }
+}
+
+TEST_CASE("In-place quantity reduction", "[OrderBook]") {
+    OrderBook book;
+    auto first = createLimitOrderTest(1, 100.0, 10.0, false);
+    auto second = createLimitOrderTest(2, 100.0, 5.0, false);
+    book.addOrder(first);
+    book.addOrder(second);
+
+    REQUIRE(book.reduceQuantity(first->getId(), 3.0) == BookStatus::OK);
+    REQUIRE(first->getQuantity() == Qty(3.0));
+    REQUIRE(book.getLowestAsk() == first);
+    REQUIRE(book.getTopOfBook().ask.quantity == Qty(8.0));
+    REQUIRE(book.getTopOfBook().ask.orderCount == 2);
+    REQUIRE(book.getDepth(false, 1) == Qty(8.0));
+
+    // Only genuine decreases are accepted
+    REQUIRE(book.reduceQuantity(first->getId(), 3.0) == BookStatus::INVALID_ORDER);
+    REQUIRE(book.reduceQuantity(first->getId(), 4.0) == BookStatus::INVALID_ORDER);
+    REQUIRE(book.reduceQuantity(first->getId(), 0.0) == BookStatus::INVALID_ORDER);
+    REQUIRE(book.reduceQuantity(999999, 1.0) == BookStatus::NOT_FOUND);
+    REQUIRE(book.getDiagnostics().invalidOrders == 3);
+}
+
+TEST_CASE("Level-sweeping match", "[OrderBook]") {
+    OrderBook book;
+    auto ask1 = createLimitOrderTest(1, 100.0, 5.0, false);
+    auto ask2 = createLimitOrderTest(2, 100.0, 5.0, false);
+    auto ask3 = createLimitOrderTest(3, 101.0, 4.0, false);
+    auto ask4 = createLimitOrderTest(4, 103.0, 6.0, false);
+    book.addOrder(ask1);
+    book.addOrder(ask2);
+    book.addOrder(ask3);
+    book.addOrder(ask4);
+
+    struct Fill {
+        OrderId restingId;
+        Price price;
+        Qty quantity;
+    };
+    std::vector<Fill> fills;
+    auto record = [&fills](const Order& resting, Price price, Qty quantity) {
+        fills.push_back(Fill{resting.getId(), price, quantity});
+    };
+
+    SECTION("Sweeps levels best first and FIFO within a level, up to the limit") {
+        auto buy = createLimitOrderTest(9, 102.0, 12.0, true);
+        REQUIRE(book.match(*buy, buy->getPrice(), record) == Qty(12.0));
+
+        REQUIRE(fills.size() == 3);
+        REQUIRE(fills[0].restingId == ask1->getId());
+        REQUIRE(fills[1].restingId == ask2->getId());
+        REQUIRE(fills[2].restingId == ask3->getId());
+        REQUIRE(fills[2].price == Price(101.0));
+        REQUIRE(fills[2].quantity == Qty(2.0));
+        REQUIRE(buy->getQuantity() == Qty(0.0));
+
+        // Exhausted orders are gone; the partly filled one keeps its place
+        REQUIRE_FALSE(book.findOrder(ask1->getId()));
+        REQUIRE_FALSE(book.findOrder(ask2->getId()));
+        REQUIRE(book.findOrder(ask3->getId()));
+        REQUIRE(ask3->getQuantity() == Qty(2.0));
+
+        BookTop topAsk = book.getTopOfBook().ask;
+        REQUIRE(topAsk.price == Price(101.0));
+        REQUIRE(topAsk.quantity == Qty(2.0));
+        REQUIRE(topAsk.orderCount == 1);
+    }
+
+    SECTION("Stops at the limit and leaves the remainder on the incoming order") {
+        auto buy = createLimitOrderTest(9, 101.0, 20.0, true);
+        REQUIRE(book.match(*buy, buy->getPrice(), record) == Qty(14.0));
+        REQUIRE(buy->getQuantity() == Qty(6.0));
+        REQUIRE(book.getTopOfBook().ask.price == Price(103.0));
+        REQUIRE(book.getDepth(false, 10) == Qty(6.0));
+    }
+
+    SECTION("An unbounded limit empties the side") {
+        auto smallBuy = createLimitOrderTest(9, 99.0, 1.0, true);
+        REQUIRE(book.match(*smallBuy, Price::max(), record) == Qty(1.0));
+        auto marketBuy = std::make_shared<MarketOrder>(9, 50.0, true);
+        REQUIRE(book.match(*marketBuy, Price::max(), record) == Qty(19.0));
+        REQUIRE(marketBuy->getQuantity() == Qty(31.0));
+        REQUIRE(book.isEmpty());
+        REQUIRE(book.getTopOfBook().ask.orderCount == 0);
+    }
+
+    SECTION("Sells sweep the bids from the highest price down") {
+        OrderBook bidBook;
+        auto bid1 = createLimitOrderTest(1, 99.0, 3.0, true);
+        auto bid2 = createLimitOrderTest(2, 98.0, 3.0, true);
+        bidBook.addOrder(bid2);
+        bidBook.addOrder(bid1);
+
+        auto sell = createLimitOrderTest(9, 98.0, 4.0, false);
+        REQUIRE(bidBook.match(*sell, sell->getPrice(), record) == Qty(4.0));
+        REQUIRE(fills[0].restingId == bid1->getId());
+        REQUIRE(fills[1].restingId == bid2->getId());
+        REQUIRE(bidBook.getTopOfBook().bid.quantity == Qty(2.0));
+    }
+
+    SECTION("No fill when the best price does not cross") {
+        auto buy = createLimitOrderTest(9, 99.0, 1.0, true);
+        REQUIRE(book.match(*buy, buy->getPrice(), record) == Qty(0.0));
+        REQUIRE(fills.empty());
+        REQUIRE(book.getTopOfBook().ask.quantity == Qty(10.0));
+    }
+}
+
+TEST_CASE("Auction clearing price", "[OrderBook]") {
+    OrderBook book;
+    book.addOrder(createLimitOrderTest(1, 102.0, 5.0, true));
+    book.addOrder(createLimitOrderTest(1, 101.0, 5.0, true));
+    book.addOrder(createLimitOrderTest(1, 100.0, 12.0, true));
+    book.addOrder(createLimitOrderTest(2, 99.0, 4.0, false));
+    book.addOrder(createLimitOrderTest(2, 100.0, 6.0, false));
+    book.addOrder(createLimitOrderTest(2, 101.0, 10.0, false));
+
+    SECTION("Maximises volume, then minimises imbalance") {
+        // 100 and 101 both clear 10; 101 leaves the smaller imbalance
+        AuctionClearing clearing = book.getClearingPrice();
+        REQUIRE(clearing.price == 101.0);
+        REQUIRE(clearing.volume == 10.0);
+        REQUIRE(clearing.imbalance == 10.0);
+    }
+
+    SECTION("Market quantity counts at every price") {
+        AuctionClearing clearing = book.getClearingPrice(3.0, Qty());
+        REQUIRE(clearing.price == 101.0);
+        REQUIRE(clearing.volume == 13.0);
+        REQUIRE(clearing.imbalance == 7.0);
+    }
+
+    SECTION("Nothing clears when the book does not cross") {
+        OrderBook quiet;
+        quiet.addOrder(createLimitOrderTest(1, 99.0, 5.0, true));
+        quiet.addOrder(createLimitOrderTest(2, 100.0, 5.0, false));
+        REQUIRE(quiet.getClearingPrice().volume == Qty());
+    }
+}
+
+TEST_CASE("Iceberg replenishment", "[OrderBook]") {
+    OrderBook book;
+    auto iceberg = std::make_shared<IcebergOrder>(1, 100.0, 25.0, 10.0, false);
+    auto plain = createLimitOrderTest(2, 100.0, 5.0, false);
+    book.addOrder(iceberg);
+    book.addOrder(plain);
+
+    SECTION("Only the display size is visible") {
+        REQUIRE(iceberg->getQuantity() == 10.0);
+        REQUIRE(iceberg->getHiddenQuantity() == 15.0);
+        REQUIRE(book.getTopOfBook().ask.quantity == 15.0);
+        LevelView levels[1];
+        REQUIRE(book.snapshotDepth(false, 1, levels) == 1);
+        REQUIRE(levels[0].quantity == 15.0);
+
+        // The reserve still counts towards what a sweep can take
+        REQUIRE(book.getCrossingDepth(true, 100.0, 100.0) == 30.0);
+    }
+
+    SECTION("A filled slice is refreshed at the back of the queue") {
+        auto buy = createLimitOrderTest(3, 100.0, 12.0, true);
+        std::vector<OrderId> fills;
+        book.match(*buy, buy->getPrice(), [&](const Order& resting, Price, Qty) {
+            fills.push_back(resting.getId());
+        });
+
+        // 10 from the slice, then the plain order that is now ahead of it
+        REQUIRE(fills.size() == 2);
+        REQUIRE(fills[0] == iceberg->getId());
+        REQUIRE(fills[1] == plain->getId());
+        REQUIRE(iceberg->getQuantity() == 10.0);
+        REQUIRE(iceberg->getHiddenQuantity() == 5.0);
+        REQUIRE(book.getTopOfBook().ask.quantity == 13.0);
+        REQUIRE(book.tryBestAsk().value == plain.get());
+    }
+
+    SECTION("The reserve drains slice by slice until the order leaves") {
+        REQUIRE(book.fillOrder(iceberg->getId(), 10.0));
+        REQUIRE(iceberg->getQuantity() == 10.0);
+        REQUIRE(book.getTopOfBook().ask.quantity == 15.0);
+        REQUIRE(book.fillOrder(iceberg->getId(), 10.0));
+        REQUIRE(iceberg->getQuantity() == 5.0);
+        REQUIRE(book.getTopOfBook().ask.quantity == 10.0);
+        REQUIRE(book.getCrossingDepth(true, 100.0, 100.0) == 10.0);
+        REQUIRE(book.fillOrder(iceberg->getId(), 5.0));
+        REQUIRE(book.findOrder(iceberg->getId()) == nullptr);
+        REQUIRE(book.getTopOfBook().ask.quantity == 5.0);
+        REQUIRE(book.getTopOfBook().ask.orderCount == 1);
+    }
+
+    SECTION("Reductions apply to the total, reserve first") {
+        REQUIRE(book.reduceQuantity(iceberg->getId(), 25.0) == BookStatus::INVALID_ORDER);
+        REQUIRE(book.reduceQuantity(iceberg->getId(), 18.0) == BookStatus::OK);
+        REQUIRE(iceberg->getQuantity() == 10.0);
+        REQUIRE(iceberg->getHiddenQuantity() == 8.0);
+        REQUIRE(book.getTopOfBook().ask.quantity == 15.0);
+        REQUIRE(book.getCrossingDepth(true, 100.0, 100.0) == 23.0);
+
+        REQUIRE(book.reduceQuantity(iceberg->getId(), 4.0) == BookStatus::OK);
+        REQUIRE(iceberg->getQuantity() == 4.0);
+        REQUIRE(iceberg->getHiddenQuantity() == Qty());
+        REQUIRE(book.getTopOfBook().ask.quantity == 9.0);
+        REQUIRE(book.getCrossingDepth(true, 100.0, 100.0) == 9.0);
+        REQUIRE(book.tryBestAsk().value == iceberg.get());
+    }
+}
+
+TEST_CASE("Self-trade prevention", "[OrderBook]") {
+    OrderBook book;
+    auto own = createLimitOrderTest(1, 100.0, 5.0, false);
+    auto other = createLimitOrderTest(2, 100.0, 5.0, false);
+    book.addOrder(own);
+    book.addOrder(other);
+    auto buy = createLimitOrderTest(1, 100.0, 8.0, true);
+    Qty traded;
+    auto onFill = [&](const Order& resting, Price, Qty quantity) {
+        REQUIRE(resting.getTraderId() != buy->getTraderId());
+        traded += quantity;
+    };
+
+    SECTION("Without prevention the trader trades with itself") {
+        REQUIRE(book.match(*buy, buy->getPrice(), [&](const Order&, Price, Qty quantity) {
+            traded += quantity;
+        }) == 8.0);
+        REQUIRE(book.getDiagnostics().selfTradesPrevented == 0);
+    }
+
+    SECTION("Cancel newest stops the incoming order") {
+        REQUIRE(book.match(*buy, buy->getPrice(), onFill, SelfTradePrevention::CANCEL_NEWEST) == 0.0);
+        REQUIRE(buy->getQuantity() == 0.0);
+        REQUIRE(book.getTopOfBook().ask.quantity == 10.0);
+        REQUIRE(book.getDiagnostics().selfTradesPrevented == 1);
+    }
+
+    SECTION("Cancel oldest removes the resting order and keeps matching") {
+        REQUIRE(book.match(*buy, buy->getPrice(), onFill, SelfTradePrevention::CANCEL_OLDEST) == 5.0);
+        REQUIRE(buy->getQuantity() == 3.0);
+        REQUIRE(book.findOrder(own->getId()) == nullptr);
+        REQUIRE(book.isEmpty());
+    }
+
+    SECTION("Decrement both reduces each side without a trade") {
+        REQUIRE(book.match(*buy, buy->getPrice(), onFill, SelfTradePrevention::DECREMENT_BOTH) == 3.0);
+        REQUIRE(traded == 3.0);
+        REQUIRE(buy->getQuantity() == 0.0);
+        REQUIRE(book.findOrder(own->getId()) == nullptr);
+        REQUIRE(other->getQuantity() == 2.0);
+        REQUIRE(book.getTopOfBook().ask.quantity == 2.0);
+    }
+}
+
+TEST_CASE("Far prices", "[OrderBook]") {
+    // Prices thousands of ticks apart must not stretch a flat ladder between them
+    OrderBook book;
+    auto nearAsk = createLimitOrderTest(1, 1000.0, 5.0, false);
+    auto farAsk = createLimitOrderTest(1, 100000.0, 7.0, false);
+    auto lowAsk = createLimitOrderTest(1, 1.0, 2.0, false);
+    auto farBid = createLimitOrderTest(2, 0.5, 3.0, true);
+    book.addOrder(nearAsk);
+    book.addOrder(farAsk);
+    book.addOrder(lowAsk);
+    book.addOrder(farBid);
+
+    std::array<LevelView, 4> buffer{};
+    REQUIRE(book.snapshotDepth(false, 4, buffer) == 3);
+    REQUIRE(buffer[0].price == 1.0);
+    REQUIRE(buffer[1].price == 1000.0);
+    REQUIRE(buffer[2].price == 100000.0);
+    REQUIRE(book.getLowestAsk() == lowAsk);
+    REQUIRE(book.getHighestBid() == farBid);
+
+    // Emptying the best level falls back to the next, wherever it lives
+    REQUIRE(book.removeOrder(lowAsk->getId()));
+    REQUIRE(book.getLowestAsk() == nearAsk);
+    REQUIRE(book.removeOrder(nearAsk->getId()));
+    REQUIRE(book.getLowestAsk() == farAsk);
+
+    // A sweep walks onto a far level
+    auto buy = createLimitOrderTest(3, 100000.0, 4.0, true);
+    REQUIRE(book.match(*buy, buy->getPrice(), [](const Order&, Price, Qty) {}) == Qty(4.0));
+    REQUIRE(book.getTopOfBook().ask.quantity == Qty(3.0));
+
+    REQUIRE(book.removeOrder(farAsk->getId()));
+    REQUIRE(book.getLowestAsk() == nullptr);
+
+    // Once the side is empty the next price starts a fresh window
+    auto next = createLimitOrderTest(1, 50000.0, 1.0, false);
+    book.addOrder(next);
+    REQUIRE(book.getLowestAsk() == next);
+    REQUIRE(book.getDepth(false, 5) == Qty(1.0));
+}
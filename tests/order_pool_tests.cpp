@@ -0,0 +1,74 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "../src/order_pool.hpp"
+#include "../src/exchange.hpp"
+#include "../src/trader.hpp"
+
+using namespace trading;
+
+TEST_CASE("OrderPool Methods", "[OrderPool]") {
+
+    SECTION("Slots are recycled") {
+        OrderPool* pool = OrderPool::create(4);
+        REQUIRE(pool->slotCount() == 4);
+
+        void* first = pool->allocate(64);
+        REQUIRE(pool->slotsInUse() == 1);
+        pool->deallocate(first, 64);
+        REQUIRE(pool->slotsInUse() == 0);
+
+        // The freed slot is handed out again
+        void* second = pool->allocate(64);
+        REQUIRE(second == first);
+        pool->deallocate(second, 64);
+        pool->release();
+    }
+
+    SECTION("Pool grows by whole slabs") {
+        OrderPool* pool = OrderPool::create(2);
+        std::vector<void*> slots;
+        for (int i = 0; i < 5; ++i) {
+            slots.push_back(pool->allocate(OrderPool::SLOT_SIZE));
+        }
+        REQUIRE(pool->slotCount() == 6);
+        REQUIRE(pool->slotsInUse() == 5);
+        for (void* slot : slots) {
+            pool->deallocate(slot, OrderPool::SLOT_SIZE);
+        }
+        REQUIRE(pool->slotsInUse() == 0);
+        pool->release();
+    }
+}
+
+TEST_CASE("Exchange order pool", "[OrderPool]") {
+
+    SECTION("Trader orders come from the exchange pool") {
+        Exchange exchange;
+        auto trader = exchange.registerTrader();
+        {
+            auto limit = trader->createLimitOrder(100.0, 10.0, true);
+            auto market = trader->createMarketOrder(5.0, false);
+            REQUIRE(exchange.getOrderPool().slotsInUse() == 2);
+        }
+        REQUIRE(exchange.getOrderPool().slotsInUse() == 0);
+
+        // Steady-state requotes reuse the same slots
+        std::size_t slots = exchange.getOrderPool().slotCount();
+        for (int i = 0; i < 10000; ++i) {
+            auto quote = trader->createLimitOrder(100.0, 1.0, true);
+            exchange.submitOrder(quote);
+            exchange.cancelOrder(quote->getId());
+        }
+        REQUIRE(exchange.getOrderPool().slotCount() == slots);
+    }
+
+    SECTION("Orders may outlive the exchange") {
+        std::shared_ptr<LimitOrder> survivor;
+        {
+            Exchange exchange;
+            survivor = exchange.createOrder<LimitOrder>(1, 100.0, 10.0, true);
+            exchange.submitOrder(survivor);
+        }
+        REQUIRE(survivor->getPrice() == 100.0);
+    }
+}
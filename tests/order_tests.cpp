@@ -5,41 +5,103 @@
 using namespace trading;
 
 // Helper function to create a limit order
-std::shared_ptr<LimitOrder> createLimitOrderTest(const std::string& traderId, double price, double quantity, bool isBuy) {
+std::shared_ptr<LimitOrder> createLimitOrderTest(TraderId traderId, double price, double quantity, bool isBuy) {
     return std::make_shared<LimitOrder>(traderId, price, quantity, isBuy);
 }
 
 // Helper function to create a market order
-std::shared_ptr<MarketOrder> createMarketOrderTest(const std::string& traderId, double quantity, bool isBuy) {
+std::shared_ptr<MarketOrder> createMarketOrderTest(TraderId traderId, double quantity, bool isBuy) {
     return std::make_shared<MarketOrder>(traderId, quantity, isBuy);
 }
 
 TEST_CASE("LimitOrder Creation", "[LimitOrder]") {
 
     SECTION("Valid Limit Order") {
-        REQUIRE_NOTHROW(LimitOrder("trader123", 50.5, 100, true));
+        REQUIRE_NOTHROW(LimitOrder(123, 50.5, 100, true));
 
-        auto order = createLimitOrderTest("trader123", 50.5, 100, true);
+        auto order = createLimitOrderTest(123, 50.5, 100, true);
         REQUIRE(order->getPrice() == 50.5);
         REQUIRE(order->getQuantity() == 100);
         REQUIRE(order->isBuyOrder() == true);
     }
 
     SECTION("Invalid Limit Orders") {
-        REQUIRE_THROWS_AS(LimitOrder("trader123", 50.5, -100, true), std::invalid_argument);
-        REQUIRE_THROWS_AS(LimitOrder("trader123", -10.0, 100, true), std::invalid_argument);
-        REQUIRE_THROWS_AS(LimitOrder("trader123", 50.5, 0, true), std::invalid_argument);
-        REQUIRE_THROWS_AS(LimitOrder("trader123", 0, 100, true), std::invalid_argument);
+        REQUIRE_THROWS_AS(LimitOrder(123, 50.5, -100, true), std::invalid_argument);
+        REQUIRE_THROWS_AS(LimitOrder(123, -10.0, 100, true), std::invalid_argument);
+        REQUIRE_THROWS_AS(LimitOrder(123, 50.5, 0, true), std::invalid_argument);
+        REQUIRE_THROWS_AS(LimitOrder(123, 0, 100, true), std::invalid_argument);
     }
 }
 
 TEST_CASE("MarketOrder Creation", "[MarketOrder]") {
 
     SECTION("Valid Market Order") {
-        REQUIRE_NOTHROW(MarketOrder("trader123", 100, true));
+        REQUIRE_NOTHROW(MarketOrder(123, 100, true));
 
-        auto order = createMarketOrderTest("trader123", 200, false);
+        auto order = createMarketOrderTest(123, 200, false);
         REQUIRE(order->getQuantity() == 200);
         REQUIRE(order->isBuyOrder() == false);
     }
 }
+
+TEST_CASE("IOC and FOK Order Creation", "[LimitOrder]") {
+
+    SECTION("Carry a limit price and their own type") {
+        IocOrder ioc(123, 50.0, 10.0, true);
+        REQUIRE(ioc.getType() == OrderType::IOC);
+        REQUIRE(ioc.getPrice() == 50.0);
+
+        FokOrder fok(123, 50.0, 10.0, false);
+        REQUIRE(fok.getType() == OrderType::FOK);
+        REQUIRE(fok.toString().find("FOK") != std::string::npos);
+    }
+
+    SECTION("Validate like limit orders") {
+        REQUIRE_THROWS_AS(IocOrder(123, -1.0, 10.0, true), std::invalid_argument);
+        REQUIRE_THROWS_AS(FokOrder(123, 50.0, 0.0, true), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Order IDs", "[Order]") {
+
+    SECTION("Sequential numeric IDs") {
+        auto first = createLimitOrderTest(7, 50.0, 1.0, true);
+        auto second = createMarketOrderTest(7, 1.0, false);
+        REQUIRE(second->getId() == first->getId() + 1);
+        REQUIRE(first->getTraderId() == 7);
+    }
+
+    SECTION("Display formatting") {
+        REQUIRE(formatOrderId(42) == "ORD-42");
+        REQUIRE(formatTraderId(3) == "TRD-3");
+        auto order = createLimitOrderTest(3, 50.0, 1.0, true);
+        REQUIRE(order->toString().find(formatOrderId(order->getId())) != std::string::npos);
+        REQUIRE(order->toString().find("TRD-3") != std::string::npos);
+    }
+}
+
+TEST_CASE("Fixed-point Price and Qty", "[FixedPoint]") {
+
+    SECTION("Rounding to ticks and lots") {
+        REQUIRE(Price(100.004).raw() == 100 * Price::scale);
+        REQUIRE(Price(100.006) == Price(100.01));
+        REQUIRE(Qty(2.5).raw() == 2500 * Qty::scale / 1000);
+        REQUIRE(Price::fromRaw(10050).toDouble() == Approx(10050 * Price::resolution()));
+    }
+
+    SECTION("Exact integer arithmetic") {
+        Qty remaining(0.3);
+        remaining -= Qty(0.1);
+        remaining -= Qty(0.2);
+        REQUIRE(remaining == Qty());
+        REQUIRE(Price(99.99) < Price(100.0));
+        REQUIRE(Price(0.1) + Price(0.2) == Price(0.3));
+    }
+
+    SECTION("Orders store fixed-point values") {
+        auto order = createLimitOrderTest(123, 50.504, 1.0005, true);
+        REQUIRE(order->getPrice() == Price(50.50));
+        REQUIRE(order->getQuantity().raw() == Qty(1.0005).raw());
+        REQUIRE_THROWS_AS(LimitOrder(123, 0.001, 1.0, true), std::invalid_argument);
+    }
+}
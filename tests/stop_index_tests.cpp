@@ -0,0 +1,60 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "../src/stop_index.hpp"
+#include <memory>
+#include <vector>
+
+using namespace trading;
+
+TEST_CASE("StopIndex Methods", "[StopIndex]") {
+    StopIndex index;
+    auto buyLow = std::make_shared<StopOrder>(1, 101.0, 1.0, true);
+    auto buyHigh = std::make_shared<StopLimitOrder>(1, 105.0, 106.0, 1.0, true);
+    auto buyLowLater = std::make_shared<StopOrder>(1, 101.0, 2.0, true);
+    auto sellHigh = std::make_shared<StopOrder>(2, 99.0, 1.0, false);
+    auto sellLow = std::make_shared<StopOrder>(2, 95.0, 1.0, false);
+    REQUIRE(index.add(buyHigh));
+    REQUIRE(index.add(buyLow));
+    REQUIRE(index.add(buyLowLater));
+    REQUIRE(index.add(sellLow));
+    REQUIRE(index.add(sellHigh));
+
+    SECTION("Only stops and only once") {
+        REQUIRE_FALSE(index.add(buyLow));
+        REQUIRE_FALSE(index.add(std::make_shared<LimitOrder>(1, 100.0, 1.0, true)));
+        REQUIRE(index.size() == 5);
+    }
+
+    SECTION("A trade releases the stops it reaches, in stop-price then arrival order") {
+        std::vector<std::shared_ptr<Order>> released;
+        index.release(100.0, released);
+        REQUIRE(released.empty());
+
+        index.release(102.0, released);
+        REQUIRE(released.size() == 2);
+        REQUIRE(released[0] == buyLow);
+        REQUIRE(released[1] == buyLowLater);
+        REQUIRE(buyLow->isTriggered());
+        REQUIRE(buyLow->getType() == OrderType::MARKET);
+        REQUIRE_FALSE(buyHigh->isTriggered());
+
+        released.clear();
+        index.release(94.0, released);
+        REQUIRE(released.size() == 2);
+        REQUIRE(released[0] == sellHigh);
+        REQUIRE(released[1] == sellLow);
+        REQUIRE(index.size() == 1);
+        REQUIRE(index.contains(buyHigh->getId()));
+    }
+
+    SECTION("Removed stops are never released") {
+        REQUIRE(index.remove(buyLow->getId()));
+        REQUIRE_FALSE(index.remove(buyLow->getId()));
+        std::vector<std::shared_ptr<Order>> released;
+        index.release(110.0, released);
+        REQUIRE(released.size() == 2);
+        REQUIRE(released[1] == buyHigh);
+        REQUIRE(buyHigh->getType() == OrderType::LIMIT);
+        REQUIRE(index.size() == 2);
+    }
+}
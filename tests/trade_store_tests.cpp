@@ -0,0 +1,120 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "../src/trade_store.hpp"
+#include "../src/exchange.hpp"
+#include "../src/trader.hpp"
+
+using namespace trading;
+
+// Trade with distinct values derived from i
+static Trade makeTrade(std::size_t i) {
+    Trade trade;
+    trade.buyOrderId = 2 * i;
+    trade.sellOrderId = 2 * i + 1;
+    trade.buyTraderId = i % 3;
+    trade.sellTraderId = i % 5;
+    trade.price = Price::fromRaw(10000 + static_cast<std::int64_t>(i));
+    trade.quantity = Qty::fromRaw(1000 + static_cast<std::int64_t>(i));
+    trade.aggressorIsBuy = i % 2 == 0;
+    trade.timestamp = static_cast<Timestamp>(i * 10);
+    return trade;
+}
+
+TEST_CASE("TradeStore Methods", "[TradeStore]") {
+    TradeStore store;
+
+    SECTION("Empty store") {
+        REQUIRE(store.empty());
+        REQUIRE(store.size() == 0);
+        REQUIRE(store.chunkCount() == 0);
+        REQUIRE(store.bytesReserved() == 0);
+    }
+
+    SECTION("Rows round-trip through the columns") {
+        store.append(makeTrade(7));
+        REQUIRE(store.size() == 1);
+
+        Trade trade = store.back();
+        REQUIRE(trade.buyOrderId == 14);
+        REQUIRE(trade.sellOrderId == 15);
+        REQUIRE(trade.buyTraderId == 1);
+        REQUIRE(trade.sellTraderId == 2);
+        REQUIRE(trade.price == Price::fromRaw(10007));
+        REQUIRE(trade.quantity == Qty::fromRaw(1007));
+        REQUIRE_FALSE(trade.aggressorIsBuy);
+        REQUIRE(trade.timestamp == 70);
+    }
+
+    SECTION("Growth adds whole chunks and keeps earlier trades") {
+        const std::size_t total = TradeStore::CHUNK_SIZE * 2 + 5;
+        for (std::size_t i = 0; i < total; ++i) {
+            store.append(makeTrade(i));
+        }
+        REQUIRE(store.size() == total);
+        REQUIRE(store.chunkCount() == 3);
+        REQUIRE(store[0].buyOrderId == 0);
+        REQUIRE(store[TradeStore::CHUNK_SIZE].sellOrderId == 2 * TradeStore::CHUNK_SIZE + 1);
+        REQUIRE(store.back().timestamp == static_cast<Timestamp>((total - 1) * 10));
+
+        // Columns cover exactly the stored trades
+        std::size_t seen = 0;
+        std::int64_t priceSum = 0;
+        std::size_t buyAggressors = 0;
+        store.forEachChunk([&](const TradeColumns& columns) {
+            seen += columns.size();
+            for (Price price : columns.prices) {
+                priceSum += price.raw();
+            }
+            for (std::uint8_t isBuy : columns.aggressorIsBuy) {
+                buyAggressors += isBuy;
+            }
+        });
+        REQUIRE(seen == total);
+        REQUIRE(store.columns(2).size() == 5);
+        REQUIRE(buyAggressors == (total + 1) / 2);
+
+        std::int64_t expected = 0;
+        for (std::size_t i = 0; i < total; ++i) {
+            expected += 10000 + static_cast<std::int64_t>(i);
+        }
+        REQUIRE(priceSum == expected);
+
+        store.clear();
+        REQUIRE(store.empty());
+        REQUIRE(store.chunkCount() == 0);
+    }
+
+    SECTION("Exchange records the aggressor side") {
+        Exchange exchange;
+        auto maker = exchange.registerTrader();
+        auto taker = exchange.registerTrader();
+        exchange.submitOrder(maker->createLimitOrder(100.0, 5.0, true));
+        exchange.submitOrder(taker->createMarketOrder(2.0, false));
+
+        const TradeStore& trades = exchange.getTrades();
+        REQUIRE(trades.size() == 1);
+        REQUIRE_FALSE(trades.back().aggressorIsBuy);
+        REQUIRE(trades.back().sellTraderId == taker->getId());
+        REQUIRE(trades.columns(0).quantities[0] == Qty(2.0));
+    }
+}
+
+TEST_CASE("TradeStore reservation", "[TradeStore]") {
+    TradeStore store;
+    store.reserve(TradeStore::CHUNK_SIZE + 1);
+    REQUIRE(store.bytesReserved() > 0);
+    REQUIRE(store.chunkCount() == 0);
+
+    std::size_t reserved = store.bytesReserved();
+    for (std::size_t i = 0; i < TradeStore::CHUNK_SIZE + 1; ++i) {
+        store.append(makeTrade(i));
+    }
+    REQUIRE(store.bytesReserved() == reserved);
+    REQUIRE(store.chunkCount() == 2);
+
+    std::size_t seen = 0;
+    store.forEachChunk([&seen](const TradeColumns& columns) {
+        seen += columns.size();
+    });
+    REQUIRE(seen == TradeStore::CHUNK_SIZE + 1);
+}
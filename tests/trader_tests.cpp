@@ -7,12 +7,12 @@
 using namespace trading;
 
 // Helper function to create a limit order
-std::shared_ptr<LimitOrder> createLimitOrderTest(const std::string& traderId, double price, double quantity, bool isBuy) {
+std::shared_ptr<LimitOrder> createLimitOrderTest(TraderId traderId, double price, double quantity, bool isBuy) {
     return std::make_shared<LimitOrder>(traderId, price, quantity, isBuy);
 }
 
 // Helper function to create a market order
-std::shared_ptr<MarketOrder> createMarketOrderTest(const std::string& traderId, double quantity, bool isBuy) {
+std::shared_ptr<MarketOrder> createMarketOrderTest(TraderId traderId, double quantity, bool isBuy) {
     return std::make_shared<MarketOrder>(traderId, quantity, isBuy);
 }
 
@@ -35,7 +35,7 @@ TEST_CASE("Trader", "[trader]") {
     SECTION("Constructor") {
         Exchange exchange;
         Trader trader1(&exchange);
-        REQUIRE (trader1.getId() == "TRD-1");
+        REQUIRE (trader1.getId() == 1);
     }
     
     SECTION("Create Buy Limit Order") {